@@ -0,0 +1,59 @@
+/**
+ * @file BenchUtil.h
+ * @author simin tao (taosm@pcl.ac.cn)
+ * @brief The common utility of the benchmarks.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020 PCL EDA
+ *
+ */
+
+#pragma once
+
+#include <sys/resource.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace pcl {
+namespace bench {
+
+/**
+ * @brief Parse the comma separated integer list such as "1,2,4".
+ */
+inline std::vector<int> parseList(const std::string& arg) {
+  std::vector<int> values;
+  std::stringstream ss(arg);
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    if (!item.empty()) values.push_back(std::atoi(item.c_str()));
+  }
+  return values;
+}
+
+/**
+ * @brief Get the peak resident memory of the process in KB.
+ */
+inline long peakRssKb() {
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
+}
+
+/**
+ * @brief Get the wall time of func() in seconds.
+ */
+template <typename FUNC>
+double timeit(FUNC&& func) {
+  auto start = std::chrono::steady_clock::now();
+  func();
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double>(stop - start).count();
+}
+
+}  // namespace bench
+}  // namespace pcl
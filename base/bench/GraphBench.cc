@@ -0,0 +1,277 @@
+/**
+ * @file GraphBench.cc
+ * @author simin tao (taosm@pcl.ac.cn)
+ * @brief The benchmark of the graph algorithms across graph sizes and thread
+ * numbers, the result is written in json format.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020 PCL EDA
+ *
+ * usage: base_graph_bench [--scales 12,14,16] [--threads 1,2,4]
+ *                         [--degree 8] [--seed 1] [--output result.json]
+ *
+ * The vertex number of the graph is 2^scale, the edge number is degree times
+ * of the vertex number.The parallel phases(generate, connected components and
+ * net wirelength) run with each thread number and report the speedup and
+ * scaling efficiency against the first thread number, the serial phases run
+ * with one thread.
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "AdjListGraphV.h"
+#include "BenchUtil.h"
+#include "GraphGenerator.h"
+#include "Parallel.h"
+#include "SteinerTree.h"
+
+namespace {
+
+using pcl::bench::parseList;
+using pcl::bench::peakRssKb;
+using pcl::bench::timeit;
+
+struct BenchOption {
+  std::vector<int> scales{12, 14, 16};
+  std::vector<int> threads;
+  int degree = 8;
+  uint64_t seed = 1;
+  std::string output;
+};
+
+struct BenchRecord {
+  std::string graph;
+  int scale;
+  int64_t num_vertexes;
+  int64_t num_edges;
+  std::string phase;
+  int threads;
+  double seconds;
+  double speedup;
+  double efficiency;
+  long peak_rss_kb;
+};
+
+bool parseOption(int argc, char** argv, BenchOption* option) {
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (i + 1 >= argc) {
+      std::cerr << "missing value of " << arg << std::endl;
+      return false;
+    }
+    std::string value = argv[++i];
+    if (arg == "--scales") {
+      option->scales = parseList(value);
+    } else if (arg == "--threads") {
+      option->threads = parseList(value);
+    } else if (arg == "--degree") {
+      option->degree = std::atoi(value.c_str());
+    } else if (arg == "--seed") {
+      option->seed = std::strtoull(value.c_str(), nullptr, 10);
+    } else if (arg == "--output") {
+      option->output = value;
+    } else {
+      std::cerr << "unknown option " << arg << std::endl;
+      return false;
+    }
+  }
+
+  if (option->threads.empty()) {
+    for (int t = 1; t <= pcl::defaultThreadNum(); t *= 2) {
+      option->threads.push_back(t);
+    }
+  }
+  return !option->scales.empty();
+}
+
+class GraphBench {
+ public:
+  explicit GraphBench(const BenchOption& option) : _option(option) {}
+
+  void run() {
+    for (int scale : _option.scales) {
+      runRmat(scale);
+      runLayeredDag(scale);
+      runWirelength(scale);
+    }
+  }
+
+  void writeJson(std::ostream& out) const {
+    out << "{\n";
+    out << "  \"benchmark\": \"base_graph_bench\",\n";
+    out << "  \"hardware_threads\": " << pcl::defaultThreadNum() << ",\n";
+    out << "  \"seed\": " << _option.seed << ",\n";
+    out << "  \"peak_rss_kb\": " << peakRssKb() << ",\n";
+    out << "  \"results\": [";
+    for (size_t i = 0; i < _records.size(); ++i) {
+      const BenchRecord& r = _records[i];
+      double edges_per_second = r.seconds > 0 ? r.num_edges / r.seconds : 0;
+      out << (i == 0 ? "\n" : ",\n");
+      out << "    {\"graph\": \"" << r.graph << "\", \"scale\": " << r.scale
+          << ", \"vertexes\": " << r.num_vertexes
+          << ", \"edges\": " << r.num_edges << ", \"phase\": \"" << r.phase
+          << "\", \"threads\": " << r.threads << ", \"seconds\": " << r.seconds
+          << ", \"edges_per_second\": " << edges_per_second
+          << ", \"speedup\": " << r.speedup
+          << ", \"efficiency\": " << r.efficiency
+          << ", \"peak_rss_kb\": " << r.peak_rss_kb << "}";
+    }
+    out << "\n  ]\n}\n";
+  }
+
+ private:
+  void record(const std::string& graph, int scale, int64_t num_vertexes,
+              int64_t num_edges, const std::string& phase, int threads,
+              double seconds, double base_seconds, int base_threads) {
+    double speedup = seconds > 0 ? base_seconds / seconds : 0;
+    double efficiency = speedup * base_threads / threads;
+    _records.push_back({graph, scale, num_vertexes, num_edges, phase, threads,
+                        seconds, speedup, efficiency, peakRssKb()});
+    std::cerr << graph << " scale " << scale << " " << phase << " threads "
+              << threads << ": " << seconds << " s" << std::endl;
+  }
+
+  void recordSerial(const std::string& graph, int scale, int64_t num_vertexes,
+                    int64_t num_edges, const std::string& phase,
+                    double seconds) {
+    record(graph, scale, num_vertexes, num_edges, phase, 1, seconds, seconds,
+           1);
+  }
+
+  // Run the phase with each thread number, the phase function returns the
+  // processed edge number.
+  template <typename FUNC>
+  void recordParallel(const std::string& graph, int scale,
+                      int64_t num_vertexes, const std::string& phase,
+                      FUNC&& func) {
+    double base_seconds = 0;
+    for (size_t i = 0; i < _option.threads.size(); ++i) {
+      int threads = _option.threads[i];
+      int64_t num_edges = 0;
+      double seconds = timeit([&]() { num_edges = func(threads); });
+      if (i == 0) base_seconds = seconds;
+      record(graph, scale, num_vertexes, num_edges, phase, threads, seconds,
+             base_seconds, _option.threads[0]);
+    }
+  }
+
+  void runRmat(int scale) {
+    int num_vertexes = 1 << scale;
+    int64_t num_edges = static_cast<int64_t>(num_vertexes) * _option.degree;
+    pcl::Vector<pcl::GraphEdge> edges;
+    recordParallel("rmat", scale, num_vertexes, "generate", [&](int threads) {
+      pcl::GraphGenerator generator(_option.seed, threads);
+      generator.rmat(scale, num_edges, &edges);
+      return num_edges;
+    });
+
+    pcl::Graph graph(num_vertexes);
+    double seconds = timeit([&]() { graph.insertEdges(edges); });
+    int64_t graph_edges = graph.getNumEdge();
+    recordSerial("rmat", scale, num_vertexes, num_edges, "construction",
+                 seconds);
+    pcl::Vector<pcl::GraphEdge>().swap(edges);
+
+    pcl::Vector<int> order;
+    seconds = timeit([&]() { graph.bfsOrder(0, &order); });
+    recordSerial("rmat", scale, num_vertexes, graph_edges, "bfs", seconds);
+
+    seconds = timeit([&]() { graph.dfsOrder(0, &order); });
+    recordSerial("rmat", scale, num_vertexes, graph_edges, "dfs", seconds);
+
+    pcl::Vector<int64_t> dist;
+    seconds = timeit([&]() { graph.shortestPath(0, &dist); });
+    recordSerial("rmat", scale, num_vertexes, graph_edges, "sssp", seconds);
+
+    pcl::Vector<int> component;
+    seconds = timeit([&]() { graph.stronglyConnectedComponents(&component); });
+    recordSerial("rmat", scale, num_vertexes, graph_edges, "scc", seconds);
+
+    recordParallel("rmat", scale, num_vertexes, "wcc", [&](int threads) {
+      graph.connectedComponents(&component, threads);
+      return graph_edges;
+    });
+  }
+
+  void runLayeredDag(int scale) {
+    int num_layers = 64;
+    int layer_width = std::max(1, (1 << scale) / num_layers);
+    int num_vertexes = num_layers * layer_width;
+    pcl::Vector<pcl::GraphEdge> edges;
+    recordParallel("dag", scale, num_vertexes, "generate", [&](int threads) {
+      pcl::GraphGenerator generator(_option.seed, threads);
+      generator.layeredDag(num_layers, layer_width, 0.6, &edges);
+      return static_cast<int64_t>(edges.size());
+    });
+
+    pcl::Graph graph(num_vertexes);
+    double seconds = timeit([&]() { graph.insertEdges(edges); });
+    recordSerial("dag", scale, num_vertexes, edges.size(), "construction",
+                 seconds);
+    pcl::Vector<pcl::GraphEdge>().swap(edges);
+
+    pcl::Vector<int> order;
+    seconds = timeit([&]() { graph.topologicalOrder(&order); });
+    recordSerial("dag", scale, num_vertexes, graph.getNumEdge(),
+                 "topological_sort", seconds);
+  }
+
+  void runWirelength(int scale) {
+    int num_vertexes = 1 << scale;
+    int num_nets = num_vertexes;
+    pcl::Vector<int> net_offsets;
+    pcl::Vector<int> pins;
+    pcl::GraphGenerator generator(_option.seed);
+    generator.hypergraph(num_vertexes, num_nets, 0.6, &net_offsets, &pins, 64);
+
+    // The pins are placed on a square die randomly.
+    pcl::Vector<pcl::Point> points(pins.size());
+    for (size_t i = 0; i < pins.size(); ++i) {
+      unsigned h = static_cast<unsigned>(pins[i]) * 2654435761u;
+      points[i] = {static_cast<int>(h % 100000), static_cast<int>(h >> 16)};
+    }
+
+    pcl::Vector<int64_t> wirelength;
+    int64_t num_edges = pins.size() - num_nets;
+    recordParallel("hypergraph", scale, num_vertexes, "steiner_wirelength",
+                   [&](int threads) {
+                     pcl::SteinerTree::batchWirelength(
+                         points, net_offsets, pcl::WirelengthModel::kSteiner,
+                         &wirelength, threads);
+                     return num_edges;
+                   });
+  }
+
+  const BenchOption& _option;
+  std::vector<BenchRecord> _records;
+};
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  BenchOption option;
+  if (!parseOption(argc, argv, &option)) {
+    return 1;
+  }
+
+  GraphBench bench(option);
+  bench.run();
+
+  if (option.output.empty()) {
+    bench.writeJson(std::cout);
+  } else {
+    std::ofstream out(option.output);
+    if (!out) {
+      std::cerr << "can not open " << option.output << std::endl;
+      return 1;
+    }
+    bench.writeJson(out);
+  }
+  return 0;
+}
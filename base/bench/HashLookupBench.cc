@@ -0,0 +1,238 @@
+/**
+ * @file HashLookupBench.cc
+ * @author simin tao (taosm@pcl.ac.cn)
+ * @brief The benchmark of the batch lookup against the per key find of
+ * HashMap and HashSet, and the parallel build of ShardedHashMap against the
+ * sequential insert of HashMap, the result is written in json format.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020 PCL EDA
+ *
+ * usage: base_hash_bench [--sizes 10,16,20,22] [--lookups 4194304]
+ *                        [--hit-percent 50] [--threads 0]
+ *                        [--output result.json]
+ *
+ * The table size is 2^size elements, the lookup keys are random and
+ * hit-percent of them are in the table.
+ */
+
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "BenchUtil.h"
+#include "HashMap.h"
+#include "HashSet.h"
+#include "ShardedHashMap.h"
+
+namespace {
+
+using pcl::bench::parseList;
+using pcl::bench::peakRssKb;
+using pcl::bench::timeit;
+
+struct BenchOption {
+  std::vector<int> sizes{10, 16, 20, 22};
+  size_t num_lookups = 1 << 22;
+  int hit_percent = 50;
+  int num_threads = 0;
+  std::string output;
+};
+
+struct BenchRecord {
+  std::string container;
+  size_t size;
+  std::string method;
+  double seconds;
+  size_t num_found;
+  size_t num_ops;
+};
+
+bool parseOption(int argc, char** argv, BenchOption* option) {
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (i + 1 >= argc) {
+      std::cerr << "missing value of " << arg << std::endl;
+      return false;
+    }
+    std::string value = argv[++i];
+    if (arg == "--sizes") {
+      option->sizes = parseList(value);
+    } else if (arg == "--lookups") {
+      option->num_lookups = std::strtoull(value.c_str(), nullptr, 10);
+    } else if (arg == "--hit-percent") {
+      option->hit_percent = std::atoi(value.c_str());
+    } else if (arg == "--threads") {
+      option->num_threads = std::atoi(value.c_str());
+    } else if (arg == "--output") {
+      option->output = value;
+    } else {
+      std::cerr << "unknown option " << arg << std::endl;
+      return false;
+    }
+  }
+  return !option->sizes.empty() && option->num_lookups > 0;
+}
+
+class HashLookupBench {
+ public:
+  explicit HashLookupBench(const BenchOption& option) : _option(option) {}
+
+  void run() {
+    for (int size : _option.sizes) {
+      runSize(static_cast<size_t>(1) << size);
+    }
+  }
+
+  void writeJson(std::ostream& out) const {
+    out << "{\n";
+    out << "  \"benchmark\": \"base_hash_bench\",\n";
+    out << "  \"lookups\": " << _option.num_lookups << ",\n";
+    out << "  \"hit_percent\": " << _option.hit_percent << ",\n";
+    out << "  \"peak_rss_kb\": " << peakRssKb() << ",\n";
+    out << "  \"results\": [";
+    for (size_t i = 0; i < _records.size(); ++i) {
+      const BenchRecord& r = _records[i];
+      // The per key method is recorded before the batch method of each pair.
+      const BenchRecord& base = _records[i - i % 2];
+      out << (i == 0 ? "\n" : ",\n");
+      out << "    {\"container\": \"" << r.container
+          << "\", \"size\": " << r.size << ", \"method\": \"" << r.method
+          << "\", \"seconds\": " << r.seconds << ", \"ns_per_op\": "
+          << r.seconds * 1e9 / r.num_ops
+          << ", \"speedup\": " << base.seconds / r.seconds
+          << ", \"found\": " << r.num_found << "}";
+    }
+    out << "\n  ]\n}\n";
+  }
+
+ private:
+  // The op is a lookup or an inserted element.
+  void record(const std::string& container, size_t size,
+              const std::string& method, double seconds, size_t num_found,
+              size_t num_ops) {
+    _records.push_back({container, size, method, seconds, num_found, num_ops});
+    std::cerr << container << " size " << size << " " << method << ": "
+              << seconds << " s" << std::endl;
+  }
+
+  void runSize(size_t size) {
+    std::mt19937_64 engine(size);
+    std::vector<uint64_t> elements(size);
+    pcl::HashMap<uint64_t, uint64_t> hmap;
+    pcl::HashSet<uint64_t> hset;
+    hmap.reserve(size);
+    hset.reserve(size);
+    for (auto& e : elements) {
+      e = engine();
+      hmap[e] = e;
+      hset.insert(e);
+    }
+
+    std::vector<uint64_t> keys(_option.num_lookups);
+    std::uniform_int_distribution<int> percent(0, 99);
+    std::uniform_int_distribution<size_t> index(0, size - 1);
+    for (auto& key : keys) {
+      key = percent(engine) < _option.hit_percent ? elements[index(engine)]
+                                                  : engine();
+    }
+
+    std::vector<const uint64_t*> values(keys.size());
+    std::unique_ptr<bool[]> found(new bool[keys.size()]);
+    size_t num_found = 0;
+
+    double seconds = timeit([&]() {
+      num_found = 0;
+      for (size_t i = 0; i < keys.size(); ++i) {
+        auto iter = hmap.find(keys[i]);
+        values[i] = iter == hmap.end() ? nullptr : &iter->second;
+        num_found += values[i] != nullptr;
+      }
+    });
+    record("HashMap", size, "find", seconds, num_found, keys.size());
+
+    seconds = timeit([&]() {
+      hmap.findBatch(keys.data(), keys.size(), values.data());
+      num_found = 0;
+      for (auto* value : values) {
+        num_found += value != nullptr;
+      }
+    });
+    record("HashMap", size, "findBatch", seconds, num_found, keys.size());
+
+    seconds = timeit([&]() {
+      num_found = 0;
+      for (size_t i = 0; i < keys.size(); ++i) {
+        found[i] = hset.contains(keys[i]);
+        num_found += found[i];
+      }
+    });
+    record("HashSet", size, "contains", seconds, num_found, keys.size());
+
+    seconds = timeit([&]() {
+      num_found = hset.containsBatch(keys.data(), keys.size(), found.get());
+    });
+    record("HashSet", size, "containsBatch", seconds, num_found, keys.size());
+
+    runBuild(size, elements);
+  }
+
+  void runBuild(size_t size, const std::vector<uint64_t>& elements) {
+    std::vector<std::pair<uint64_t, uint64_t>> pairs(elements.size());
+    for (size_t i = 0; i < elements.size(); ++i) {
+      pairs[i] = {elements[i], i};
+    }
+
+    size_t num_inserted = 0;
+    double seconds = timeit([&]() {
+      pcl::HashMap<uint64_t, uint64_t> hmap;
+      for (const auto& p : pairs) {
+        hmap.insert(p.first, p.second);
+      }
+      num_inserted = hmap.size();
+    });
+    record("HashMap", size, "insert", seconds, num_inserted, size);
+
+    seconds = timeit([&]() {
+      pcl::ShardedHashMap<uint64_t, uint64_t> smap;
+      smap.insertParallel(pairs.begin(), pairs.end(), _option.num_threads);
+      num_inserted = smap.size();
+    });
+    record("ShardedHashMap", size, "insertParallel", seconds, num_inserted,
+           size);
+  }
+
+  const BenchOption& _option;
+  std::vector<BenchRecord> _records;
+};
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  BenchOption option;
+  if (!parseOption(argc, argv, &option)) {
+    return 1;
+  }
+
+  HashLookupBench bench(option);
+  bench.run();
+
+  if (option.output.empty()) {
+    bench.writeJson(std::cout);
+  } else {
+    std::ofstream out(option.output);
+    if (!out) {
+      std::cerr << "can not open " << option.output << std::endl;
+      return 1;
+    }
+    bench.writeJson(out);
+  }
+  return 0;
+}
@@ -0,0 +1,217 @@
+/**
+ * @file VectorSearchBench.cc
+ * @author simin tao (taosm@pcl.ac.cn)
+ * @brief The benchmark of the simd search of Vector against std::find,
+ * std::count and the reverse std::find, the result is written in json format.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020 PCL EDA
+ *
+ * usage: base_vector_bench [--sizes 4,8,12,16] [--searches 1048576]
+ *                          [--hit-percent 50] [--output result.json]
+ *
+ * The vector size is 2^size elements, the searched values are random and
+ * hit-percent of them are in the vector.The kernel is SSE2 by default, build
+ * with -mavx2 to measure the AVX2 kernel.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "BenchUtil.h"
+#include "Vector.h"
+
+namespace {
+
+using pcl::bench::parseList;
+using pcl::bench::timeit;
+
+struct BenchOption {
+  std::vector<int> sizes{4, 8, 12, 16};
+  size_t num_searches = 1 << 20;
+  int hit_percent = 50;
+  std::string output;
+};
+
+struct BenchRecord {
+  std::string type;
+  size_t size;
+  std::string method;
+  double seconds;
+  size_t checksum;
+  size_t num_ops;
+};
+
+bool parseOption(int argc, char** argv, BenchOption* option) {
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (i + 1 >= argc) {
+      std::cerr << "missing value of " << arg << std::endl;
+      return false;
+    }
+    std::string value = argv[++i];
+    if (arg == "--sizes") {
+      option->sizes = parseList(value);
+    } else if (arg == "--searches") {
+      option->num_searches = std::strtoull(value.c_str(), nullptr, 10);
+    } else if (arg == "--hit-percent") {
+      option->hit_percent = std::atoi(value.c_str());
+    } else if (arg == "--output") {
+      option->output = value;
+    } else {
+      std::cerr << "unknown option " << arg << std::endl;
+      return false;
+    }
+  }
+  return !option->sizes.empty() && option->num_searches > 0;
+}
+
+class VectorSearchBench {
+ public:
+  explicit VectorSearchBench(const BenchOption& option) : _option(option) {}
+
+  void run() {
+    for (int size : _option.sizes) {
+      size_t n = static_cast<size_t>(1) << size;
+      runType<int32_t>("int32", n);
+      runType<int64_t>("int64", n);
+      runType<double>("double", n);
+    }
+  }
+
+  void writeJson(std::ostream& out) const {
+    out << "{\n";
+    out << "  \"benchmark\": \"base_vector_bench\",\n";
+    out << "  \"simd_bytes\": " << pcl::detail::kSimdBytes << ",\n";
+    out << "  \"searches\": " << _option.num_searches << ",\n";
+    out << "  \"hit_percent\": " << _option.hit_percent << ",\n";
+    out << "  \"results\": [";
+    for (size_t i = 0; i < _records.size(); ++i) {
+      const BenchRecord& r = _records[i];
+      // The std method is recorded before the Vector method of each pair.
+      const BenchRecord& base = _records[i - i % 2];
+      out << (i == 0 ? "\n" : ",\n");
+      out << "    {\"type\": \"" << r.type << "\", \"size\": " << r.size
+          << ", \"method\": \"" << r.method << "\", \"seconds\": "
+          << r.seconds << ", \"ns_per_op\": " << r.seconds * 1e9 / r.num_ops
+          << ", \"speedup\": " << base.seconds / r.seconds
+          << ", \"checksum\": " << r.checksum << "}";
+    }
+    out << "\n  ]\n}\n";
+  }
+
+ private:
+  void record(const std::string& type, size_t size, const std::string& method,
+              double seconds, size_t checksum, size_t num_ops) {
+    _records.push_back({type, size, method, seconds, checksum, num_ops});
+    std::cerr << type << " size " << size << " " << method << ": " << seconds
+              << " s" << std::endl;
+  }
+
+  template <typename T>
+  void runType(const std::string& type, size_t size) {
+    std::mt19937_64 engine(size);
+    pcl::HeapVector<T> values(size);
+    for (size_t i = 0; i < size; ++i) {
+      values[i] = static_cast<T>(2 * i);
+    }
+    std::shuffle(values.begin(), values.end(), engine);
+
+    // The odd values are not in the vector.
+    std::vector<T> needles(std::max<size_t>(_option.num_searches / size, 1));
+    std::uniform_int_distribution<int> percent(0, 99);
+    std::uniform_int_distribution<size_t> index(0, size - 1);
+    for (auto& needle : needles) {
+      size_t i = 2 * index(engine);
+      needle = static_cast<T>(percent(engine) < _option.hit_percent ? i : i + 1);
+    }
+    size_t num_ops = needles.size() * size;
+
+    size_t checksum = 0;
+    double seconds = timeit([&]() {
+      checksum = 0;
+      for (const T& needle : needles) {
+        checksum += std::find(values.begin(), values.end(), needle) -
+                    values.begin();
+      }
+    });
+    record(type, size, "std::find", seconds, checksum, num_ops);
+
+    seconds = timeit([&]() {
+      checksum = 0;
+      for (const T& needle : needles) {
+        int i = values.indexOf(needle);
+        checksum += i < 0 ? size : static_cast<size_t>(i);
+      }
+    });
+    record(type, size, "indexOf", seconds, checksum, num_ops);
+
+    seconds = timeit([&]() {
+      checksum = 0;
+      for (const T& needle : needles) {
+        checksum += std::count(values.begin(), values.end(), needle);
+      }
+    });
+    record(type, size, "std::count", seconds, checksum, num_ops);
+
+    seconds = timeit([&]() {
+      checksum = 0;
+      for (const T& needle : needles) {
+        checksum += values.count(needle);
+      }
+    });
+    record(type, size, "count", seconds, checksum, num_ops);
+
+    seconds = timeit([&]() {
+      checksum = 0;
+      for (const T& needle : needles) {
+        auto iter = std::find(values.rbegin(), values.rend(), needle);
+        checksum += iter == values.rend() ? size : values.rend() - iter - 1;
+      }
+    });
+    record(type, size, "reverse std::find", seconds, checksum, num_ops);
+
+    seconds = timeit([&]() {
+      checksum = 0;
+      for (const T& needle : needles) {
+        int i = values.endIndexOf(needle);
+        checksum += i < 0 ? size : static_cast<size_t>(i);
+      }
+    });
+    record(type, size, "endIndexOf", seconds, checksum, num_ops);
+  }
+
+  const BenchOption& _option;
+  std::vector<BenchRecord> _records;
+};
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  BenchOption option;
+  if (!parseOption(argc, argv, &option)) {
+    return 1;
+  }
+
+  VectorSearchBench bench(option);
+  bench.run();
+
+  if (option.output.empty()) {
+    bench.writeJson(std::cout);
+  } else {
+    std::ofstream out(option.output);
+    if (!out) {
+      std::cerr << "can not open " << option.output << std::endl;
+      return 1;
+    }
+    bench.writeJson(out);
+  }
+  return 0;
+}
@@ -1,15 +1,22 @@
 #include "AdjListGraphV.h"
 
+#include <algorithm>
+#include <atomic>
+#include <functional>
 #include <iostream>
 #include <queue>
+#include <utility>
+#include <vector>
 
 #include "List.h"
+#include "Parallel.h"
 #include "Vector.h"
 namespace pcl {
 
 Graph::Graph(int numVer) {
   this->numVer = numVer;
   numEdge = 0;
+  numDisabledEdge = 0;
 
   adjVector = new Vector<Vertex>(numVer);
   for (int i = 0; i < numVer; i++) {
@@ -56,6 +63,7 @@ void Graph::insertEdge(int tail, int head, int weight) {
       r = new Edge;
       r->adjvex = head;
       r->weight = weight;
+      r->disabled = false;
       r->next = p;
 
       if ((*adjVector)[tail].next == p)
@@ -70,6 +78,7 @@ void Graph::insertEdge(int tail, int head, int weight) {
     p = new Edge;
     p->adjvex = head;
     p->weight = weight;
+    p->disabled = false;
     p->next = nullptr;
     (*adjVector)[tail].next = p;
     numEdge++;
@@ -77,6 +86,50 @@ void Graph::insertEdge(int tail, int head, int weight) {
     (*adjVector)[head].indegree++;
   }
 }
+/**
+ * @brief Insert many edges at once, the same as calling insertEdge for each
+ * edge in order, but each adjacency list is merged only once, so the time
+ * complexity is O(E log E) instead of O(E * degree).
+ *
+ * @param edges The edges to be inserted.
+ */
+void Graph::insertEdges(const pcl::Vector<GraphEdge> &edges) {
+  std::vector<GraphEdge> sorted(edges.begin(), edges.end());
+  std::stable_sort(sorted.begin(), sorted.end(),
+                   [](const GraphEdge &e1, const GraphEdge &e2) {
+                     return e1.tail < e2.tail ||
+                            (e1.tail == e2.tail && e1.head < e2.head);
+                   });
+
+  size_t i = 0;
+  while (i < sorted.size()) {
+    int tail = sorted[i].tail;
+    Edge **link = &(*adjVector)[tail].next;
+    for (; i < sorted.size() && sorted[i].tail == tail; ++i) {
+      // The last one of the duplicate edges wins like insertEdge.
+      if (i + 1 < sorted.size() && sorted[i + 1].tail == tail &&
+          sorted[i + 1].head == sorted[i].head)
+        continue;
+
+      int head = sorted[i].head;
+      while (*link && (*link)->adjvex < head) link = &(*link)->next;
+      if (*link && (*link)->adjvex == head) {
+        (*link)->weight = sorted[i].weight;
+      } else {
+        Edge *r = new Edge;
+        r->adjvex = head;
+        r->weight = sorted[i].weight;
+        r->disabled = false;
+        r->next = *link;
+        *link = r;
+        numEdge++;
+        (*adjVector)[tail].outdegree++;
+        (*adjVector)[head].indegree++;
+      }
+      link = &(*link)->next;
+    }
+  }
+}
 void Graph::printAdjVector() {
   Edge *edge = nullptr;
   for (int i = 0; i < this->numVer; i++) {
@@ -119,64 +172,439 @@ void Graph::deleteEdge(int tail, int head) {
     q->next = p->next;
   }
 
+  numEdge--;
+  (*adjVector)[tail].outdegree--;
+  (*adjVector)[head].indegree--;
+  if (p->disabled) numDisabledEdge--;
   delete p;
 }
 void Graph::BFS(int startVertex) {
-  visited = new bool[numVer];
-  for (int i = 0; i < numVer; i++) visited[i] = false;
-
-  pcl::List<int> queue;
+  pcl::Vector<int> order;
+  bfsOrder(startVertex, &order);
+  for (int ver : order) std::cout << "Visited " << ver << " ";
+}
+void Graph::DFS(int vertex) {
+  pcl::Vector<int> order;
+  dfsOrder(vertex, &order);
+  for (int ver : order) std::cout << ver << " ";
+}
 
+/**
+ * @brief Get the vertexes reached from the start vertex in breadth first
+ * order.
+ *
+ * @param startVertex The start vertex.
+ * @param order The visited vertexes.
+ */
+void Graph::bfsOrder(int startVertex, pcl::Vector<int> *order) {
+  std::vector<bool> visited(numVer, false);
+  order->clear();
   visited[startVertex] = true;
-  queue.push_back(startVertex);
-
-  // pcl::List<int>::iterator it;
-  Edge *e = nullptr;
-  while (!queue.empty()) {
-    int currVertex = queue.front();
-    std::cout << "Visited " << currVertex << " ";
-    queue.pop_front();
-    e = (*adjVector)[currVertex].next;
-    for (int i = 0; i < (*adjVector)[currVertex].outdegree; ++i) {
+  order->push_back(startVertex);
+
+  // The order is also used as the queue.
+  for (size_t front = 0; front < order->size(); ++front) {
+    int currVertex = (*order)[front];
+    for (Edge *e = (*adjVector)[currVertex].next; e; e = e->next) {
       int adjVertex = e->adjvex;
-      if (!visited[adjVertex]) {
+      if (!e->disabled && !visited[adjVertex]) {
         visited[adjVertex] = true;
-        queue.push_back(adjVertex);
+        order->push_back(adjVertex);
       }
-      e = e->next;
     }
   }
 }
-void Graph::DFS(int vertex) {
+
+/**
+ * @brief Get the vertexes reached from the start vertex in depth first
+ * preorder, the explicit stack is used for the deep graph.
+ *
+ * @param vertex The start vertex.
+ * @param order The visited vertexes.
+ */
+void Graph::dfsOrder(int vertex, pcl::Vector<int> *order) {
+  std::vector<bool> visited(numVer, false);
+  std::vector<Edge *> stack;
+  order->clear();
   visited[vertex] = true;
-  // pcl::List<int> adjVector = list[vertex];
+  order->push_back(vertex);
+  stack.push_back((*adjVector)[vertex].next);
+  while (!stack.empty()) {
+    Edge *&e = stack.back();
+    while (e && (e->disabled || visited[e->adjvex])) e = e->next;
+    if (!e) {
+      stack.pop_back();
+      continue;
+    }
+    int adjVertex = e->adjvex;
+    e = e->next;
+    visited[adjVertex] = true;
+    order->push_back(adjVertex);
+    stack.push_back((*adjVector)[adjVertex].next);
+  }
+}
 
-  std::cout << vertex << " ";
+/**
+ * @brief The single source shortest path by dijkstra algorithm, the edge
+ * weight should not be negative.
+ *
+ * @param source The source vertex.
+ * @param dist The distance from the source, the unreachable vertex is
+ * kUnreachable.
+ */
+void Graph::shortestPath(int source, pcl::Vector<int64_t> *dist) {
+  dist->assign(numVer, kUnreachable);
+  (*dist)[source] = 0;
 
-  // pcl::List<int>::iterator i;
-  for (int i = 0; i < (*adjVector)[vertex].outdegree; ++i)
-    if (!visited[i]) DFS(i);
+  using Item = std::pair<int64_t, int>;
+  std::priority_queue<Item, std::vector<Item>, std::greater<Item>> heap;
+  heap.emplace(0, source);
+  while (!heap.empty()) {
+    Item item = heap.top();
+    heap.pop();
+    int ver = item.second;
+    if (item.first > (*dist)[ver]) continue;
+    for (Edge *e = (*adjVector)[ver].next; e; e = e->next) {
+      if (e->disabled) continue;
+      int64_t d = item.first + e->weight;
+      if (d < (*dist)[e->adjvex]) {
+        (*dist)[e->adjvex] = d;
+        heap.emplace(d, e->adjvex);
+      }
+    }
+  }
+}
+
+namespace {
+
+int findRoot(std::vector<std::atomic<int>> &parent, int v) {
+  int p = parent[v].load(std::memory_order_relaxed);
+  while (p != v) {
+    // path halving, a failed exchange only means a shorter path was set.
+    int gp = parent[p].load(std::memory_order_relaxed);
+    parent[v].compare_exchange_weak(p, gp, std::memory_order_relaxed);
+    v = gp;
+    p = parent[v].load(std::memory_order_relaxed);
+  }
+  return v;
 }
+
+void unite(std::vector<std::atomic<int>> &parent, int u, int v) {
+  while (true) {
+    u = findRoot(parent, u);
+    v = findRoot(parent, v);
+    if (u == v) return;
+    // The larger root is linked to the smaller one, so no cycle is formed.
+    if (u < v) std::swap(u, v);
+    int expected = u;
+    if (parent[u].compare_exchange_strong(expected, v,
+                                          std::memory_order_relaxed))
+      return;
+  }
+}
+
+}  // namespace
+
+/**
+ * @brief The weakly connected components by the lock free union find, the
+ * vertexes are split to the threads, each thread unites the edges of its
+ * vertexes concurrently.
+ *
+ * @param component The component id of each vertex, the ids are numbered from
+ * zero in the order of the smallest vertex of the component.
+ * @param num_threads The thread number, zero means the hardware concurrency.
+ * @return int The component number.
+ */
+int Graph::connectedComponents(pcl::Vector<int> *component, int num_threads) {
+  std::vector<std::atomic<int>> parent(numVer);
+  for (int i = 0; i < numVer; ++i)
+    parent[i].store(i, std::memory_order_relaxed);
+
+  parallelFor(numVer, num_threads,
+              [this, &parent](int, size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i)
+                  for (Edge *e = (*adjVector)[i].next; e; e = e->next)
+                    if (!e->disabled)
+                      unite(parent, static_cast<int>(i), e->adjvex);
+              });
+
+  // The root is the smallest vertex of the component.
+  int num_component = 0;
+  component->resize(numVer);
+  for (int i = 0; i < numVer; ++i) {
+    int root = findRoot(parent, i);
+    (*component)[i] = root == i ? num_component++ : (*component)[root];
+  }
+  return num_component;
+}
+
 bool Graph::topological_sort() {
+  pcl::Vector<int> order;
+  bool is_dag = topologicalOrder(&order);
+  for (int ver : order) std::cout << ver << " ";
+
+  return is_dag;
+}
+
+/**
+ * @brief Get the topological order of the vertexes, the disabled edges are
+ * ignored.The graph is not changed.
+ *
+ * @param order The vertexes in topological order, the vertexes on the cycle
+ * are not in the order.
+ * @return true if the graph without disabled edges is acyclic.
+ */
+bool Graph::topologicalOrder(pcl::Vector<int> *order) {
+  std::vector<int> indegree(numVer, 0);
   for (int i = 0; i < numVer; ++i)
-    if ((*adjVector)[i].indegree == 0) que.push(i);
+    for (Edge *e = (*adjVector)[i].next; e; e = e->next)
+      if (!e->disabled) ++indegree[e->adjvex];
 
-  int count = 0;
-  while (!que.empty()) {
-    int ver = que.front();
-    que.pop();
+  order->clear();
+  order->reserve(numVer);
+  for (int i = 0; i < numVer; ++i)
+    if (indegree[i] == 0) order->push_back(i);
 
-    std::cout << ver << " ";
-    ++count;
+  // The order is also used as the queue of the zero indegree vertexes.
+  for (size_t front = 0; front < order->size(); ++front) {
+    int ver = (*order)[front];
+    for (Edge *e = (*adjVector)[ver].next; e; e = e->next)
+      if (!e->disabled && !(--indegree[e->adjvex])) order->push_back(e->adjvex);
+  }
 
-    // pcl::List<int>::iterator beg = adjVector[ver].begin();
-    for (int i = 0; i < (*adjVector)[ver].outdegree; ++i)
-      if (!(--(*adjVector)[i].indegree)) que.push(i);
+  return static_cast<int>(order->size()) == numVer;
+}
+
+void Graph::setEdgeDisabled(int tail, int head, bool disabled) {
+  for (Edge *e = (*adjVector)[tail].next; e; e = e->next) {
+    if (e->adjvex == head) {
+      if (e->disabled != disabled) {
+        e->disabled = disabled;
+        numDisabledEdge += disabled ? 1 : -1;
+      }
+      return;
+    }
   }
+}
 
-  if (count < numVer)
-    return false;
-  else
-    return true;
+void Graph::enableAllEdges() {
+  for (int i = 0; i < numVer; ++i)
+    for (Edge *e = (*adjVector)[i].next; e; e = e->next) e->disabled = false;
+  numDisabledEdge = 0;
+}
+
+/**
+ * @brief The strongly connected components by tarjan algorithm, iterative
+ * version for the deep graph, the disabled edges are ignored.
+ *
+ * @param component The component id of each vertex, the components are
+ * numbered in reverse topological order.
+ * @return int The component number.
+ */
+int Graph::stronglyConnectedComponents(pcl::Vector<int> *component) {
+  component->assign(numVer, -1);
+  std::vector<int> index(numVer, -1);
+  std::vector<int> lowlink(numVer, 0);
+  std::vector<bool> on_stack(numVer, false);
+  std::vector<int> scc_stack;
+  std::vector<std::pair<int, Edge *>> call_stack;
+  int next_index = 0;
+  int num_component = 0;
+  for (int root = 0; root < numVer; ++root) {
+    if (index[root] != -1) continue;
+    index[root] = lowlink[root] = next_index++;
+    scc_stack.push_back(root);
+    on_stack[root] = true;
+    call_stack.emplace_back(root, (*adjVector)[root].next);
+    while (!call_stack.empty()) {
+      int v = call_stack.back().first;
+      Edge *&e = call_stack.back().second;
+      while (e && e->disabled) e = e->next;
+      if (e) {
+        int w = e->adjvex;
+        e = e->next;
+        if (index[w] == -1) {
+          index[w] = lowlink[w] = next_index++;
+          scc_stack.push_back(w);
+          on_stack[w] = true;
+          call_stack.emplace_back(w, (*adjVector)[w].next);
+        } else if (on_stack[w]) {
+          lowlink[v] = std::min(lowlink[v], index[w]);
+        }
+        continue;
+      }
+
+      call_stack.pop_back();
+      if (!call_stack.empty()) {
+        int u = call_stack.back().first;
+        lowlink[u] = std::min(lowlink[u], lowlink[v]);
+      }
+      if (lowlink[v] == index[v]) {
+        int w;
+        do {
+          w = scc_stack.back();
+          scc_stack.pop_back();
+          on_stack[w] = false;
+          (*component)[w] = num_component;
+        } while (w != v);
+        ++num_component;
+      }
+    }
+  }
+
+  return num_component;
+}
+
+/**
+ * @brief Break all the cycles by disabling a small set of edges(feedback arc
+ * set), the edges are marked rather than deleted, so the graph can be
+ * levelized by topologicalOrder without copy.
+ *
+ * The strongly connected components are found by tarjan algorithm, only the
+ * edges inside a component can be on a cycle.The vertexes of the components
+ * are ordered by Eades-Lin-Smyth heuristic: repeatly move the sinks to the
+ * right, the sources to the left, otherwise the vertex of max (outdegree -
+ * indegree) to the left.The edges pointing backward in the order are disabled.
+ * The time complexity is O(V + E).
+ *
+ * @return int The number of new disabled edges.
+ */
+int Graph::breakCycles() {
+  int num_disabled = 0;
+
+  // self loop is always disabled.
+  for (int i = 0; i < numVer; ++i) {
+    for (Edge *e = (*adjVector)[i].next; e; e = e->next) {
+      if (!e->disabled && e->adjvex == i) {
+        e->disabled = true;
+        ++num_disabled;
+      }
+    }
+  }
+
+  pcl::Vector<int> component;
+  stronglyConnectedComponents(&component);
+
+  // The edges inside the components form the subgraph to be ordered.
+  auto is_inner = [&component](int tail, const Edge *e) {
+    return !e->disabled && component[tail] == component[e->adjvex];
+  };
+  std::vector<int> out_degree(numVer, 0);
+  std::vector<int> in_degree(numVer, 0);
+  std::vector<int> in_offset(numVer + 1, 0);
+  for (int i = 0; i < numVer; ++i) {
+    for (Edge *e = (*adjVector)[i].next; e; e = e->next) {
+      if (is_inner(i, e)) {
+        ++out_degree[i];
+        ++in_degree[e->adjvex];
+        ++in_offset[e->adjvex + 1];
+      }
+    }
+  }
+  if (std::all_of(out_degree.begin(), out_degree.end(),
+                  [](int degree) { return degree == 0; })) {
+    numDisabledEdge += num_disabled;
+    return num_disabled;
+  }
+
+  for (int i = 0; i < numVer; ++i) in_offset[i + 1] += in_offset[i];
+  std::vector<int> in_tails(in_offset[numVer]);
+  std::vector<int> fill(in_offset.begin(), in_offset.end() - 1);
+  int max_degree = 0;
+  for (int i = 0; i < numVer; ++i) {
+    max_degree = std::max(max_degree, std::max(in_degree[i], out_degree[i]));
+    for (Edge *e = (*adjVector)[i].next; e; e = e->next)
+      if (is_inner(i, e)) in_tails[fill[e->adjvex]++] = i;
+  }
+
+  // The vertex is in the bucket list of sink(0), source(1) or the bucket of
+  // delta = outdegree - indegree(2 + delta + max_degree).
+  const int kSink = 0;
+  const int kSource = 1;
+  std::vector<int> bucket_head(2 * max_degree + 3, -1);
+  std::vector<int> bucket(numVer, -1);
+  std::vector<int> prev(numVer, -1);
+  std::vector<int> next(numVer, -1);
+  int max_bucket = kSource;
+
+  auto unlink = [&](int v) {
+    if (prev[v] != -1)
+      next[prev[v]] = next[v];
+    else
+      bucket_head[bucket[v]] = next[v];
+    if (next[v] != -1) prev[next[v]] = prev[v];
+  };
+  auto link = [&](int v) {
+    int b = kSink;
+    if (out_degree[v] == 0)
+      b = kSink;
+    else if (in_degree[v] == 0)
+      b = kSource;
+    else
+      b = 2 + out_degree[v] - in_degree[v] + max_degree;
+    bucket[v] = b;
+    prev[v] = -1;
+    next[v] = bucket_head[b];
+    if (next[v] != -1) prev[next[v]] = v;
+    bucket_head[b] = v;
+    max_bucket = std::max(max_bucket, b);
+  };
+
+  // The position of the vertex in the order, the trivial components keep -1.
+  std::vector<int> position(numVer, -1);
+  int num_remain = 0;
+  for (int i = 0; i < numVer; ++i) {
+    if (in_degree[i] > 0 || out_degree[i] > 0) {
+      link(i);
+      ++num_remain;
+    }
+  }
+  int left = 0;
+  int right = num_remain - 1;
+
+  auto remove = [&](int v, int pos) {
+    unlink(v);
+    position[v] = pos;
+    --num_remain;
+    for (Edge *e = (*adjVector)[v].next; e; e = e->next) {
+      int w = e->adjvex;
+      if (is_inner(v, e) && position[w] == -1) {
+        unlink(w);
+        --in_degree[w];
+        link(w);
+      }
+    }
+    for (int i = in_offset[v]; i < in_offset[v + 1]; ++i) {
+      int w = in_tails[i];
+      if (position[w] == -1) {
+        unlink(w);
+        --out_degree[w];
+        link(w);
+      }
+    }
+  };
+
+  while (num_remain > 0) {
+    if (bucket_head[kSink] != -1) {
+      remove(bucket_head[kSink], right--);
+    } else if (bucket_head[kSource] != -1) {
+      remove(bucket_head[kSource], left++);
+    } else {
+      while (bucket_head[max_bucket] == -1) --max_bucket;
+      remove(bucket_head[max_bucket], left++);
+    }
+  }
+
+  for (int i = 0; i < numVer; ++i) {
+    for (Edge *e = (*adjVector)[i].next; e; e = e->next) {
+      if (is_inner(i, e) && position[i] > position[e->adjvex]) {
+        e->disabled = true;
+        ++num_disabled;
+      }
+    }
+  }
+
+  numDisabledEdge += num_disabled;
+  return num_disabled;
 }
 }  // namespace pcl
\ No newline at end of file
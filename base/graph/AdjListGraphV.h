@@ -1,4 +1,8 @@
+#pragma once
+
+#include <cstdint>
 #include <iostream>
+#include <limits>
 #include <queue>
 
 #include "Vector.h"
@@ -7,9 +11,16 @@ namespace pcl {
 struct Edge {
   int adjvex;
   int weight;
+  bool disabled;  // The disabled edge is ignored by the graph algorithm.
   Edge *next;
 };
 
+struct GraphEdge {
+  int tail;
+  int head;
+  int weight;
+};
+
 struct Vertex {
   int vertex;
   int indegree;
@@ -18,14 +29,16 @@ struct Vertex {
 };
 
 class Graph {
+ public:
+  static constexpr int64_t kUnreachable = std::numeric_limits<int64_t>::max();
+
  private:
   int numVer;
   int numEdge;
   // Vertex *adjVector;
   pcl::Vector<Vertex> *adjVector;
   // pcl::List<int> *list;
-  bool *visited;
-  std::queue<int> que;
+  int numDisabledEdge;
 
  public:
   explicit Graph(int numVer);
@@ -33,13 +46,24 @@ class Graph {
   ~Graph();
   int getNumVer() { return numVer; }
   int getNumEdge() { return numEdge; }
+  int getNumDisabledEdge() { return numDisabledEdge; }
   void insertEdge(int vertex, int adjvex, int weight);
+  void insertEdges(const pcl::Vector<GraphEdge> &edges);
   void deleteEdge(int tail, int head);
   void setWeight(int tail, int head, int weight);
   bool checkVer(int tail, int head);
   void printAdjVector();
   void BFS(int vertex);
   void DFS(int vertex);
+  void bfsOrder(int startVertex, pcl::Vector<int> *order);
+  void dfsOrder(int vertex, pcl::Vector<int> *order);
+  void shortestPath(int source, pcl::Vector<int64_t> *dist);
+  int connectedComponents(pcl::Vector<int> *component, int num_threads = 1);
+  int stronglyConnectedComponents(pcl::Vector<int> *component);
   bool topological_sort();
+  bool topologicalOrder(pcl::Vector<int> *order);
+  void setEdgeDisabled(int tail, int head, bool disabled);
+  void enableAllEdges();
+  int breakCycles();
 };
 }  // namespace pcl
\ No newline at end of file
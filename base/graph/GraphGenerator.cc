@@ -0,0 +1,279 @@
+/**
+ * @file GraphGenerator.cc
+ * @author simin tao (taosm@pcl.ac.cn)
+ * @brief The implemention of synthetic graph generator.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020 PCL EDA
+ *
+ */
+
+#include "GraphGenerator.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "Parallel.h"
+#include "absl/random/distributions.h"
+#include "absl/random/internal/pcg_engine.h"
+
+namespace pcl {
+
+namespace {
+
+// The absl::InsecureBitGen salts the seed with non-deterministic data, so the
+// pcg engine behind it is used directly to make the result reproducible.
+using RandomEngine = absl::random_internal::pcg64_2018_engine;
+
+RandomEngine blockEngine(uint64_t seed, int64_t block) {
+  std::seed_seq seq{
+      static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32),
+      static_cast<uint32_t>(block), static_cast<uint32_t>(block >> 32)};
+  return RandomEngine(seq);
+}
+
+/**
+ * @brief Generate the variable length output of each block in parallel, then
+ * concatenate the outputs in block order.
+ */
+template <typename T, typename FUNC>
+void generateBlocks(int64_t num_blocks, int num_threads, Vector<T>* result,
+                    FUNC&& func) {
+  std::vector<std::vector<T>> outputs(num_blocks);
+  parallelFor(num_blocks, num_threads,
+              [&outputs, &func](int, size_t begin, size_t end) {
+                for (size_t block = begin; block < end; ++block) {
+                  func(static_cast<int64_t>(block), &outputs[block]);
+                }
+              });
+
+  std::vector<size_t> offsets(num_blocks + 1, 0);
+  for (int64_t block = 0; block < num_blocks; ++block) {
+    offsets[block + 1] = offsets[block] + outputs[block].size();
+  }
+  result->resize(offsets[num_blocks]);
+  T* data = result->data();
+  parallelFor(num_blocks, num_threads,
+              [&outputs, &offsets, data](int, size_t begin, size_t end) {
+                for (size_t block = begin; block < end; ++block) {
+                  std::copy(outputs[block].begin(), outputs[block].end(),
+                            data + offsets[block]);
+                  std::vector<T>().swap(outputs[block]);
+                }
+              });
+}
+
+}  // namespace
+
+/**
+ * @brief The exponent of the power law fanout distribution.
+ *
+ * The net degree distribution of a netlist following Rent's rule T = t * g^p
+ * is modeled as the power law k^-(1 + 1 / (1 - p)), so a larger rent exponent
+ * means more high fanout nets.
+ *
+ * @param rent_exponent The rent exponent p in (0, 1).
+ * @return double The power law exponent.
+ */
+double GraphGenerator::rentFanoutExponent(double rent_exponent) {
+  rent_exponent = std::min(std::max(rent_exponent, 0.01), 0.99);
+  return 1.0 + 1.0 / (1.0 - rent_exponent);
+}
+
+/**
+ * @brief Generate the R-MAT graph, each edge recursively choose one of the four
+ * quadrants of the adjacency matrix with probability a, b, c and 1 - a - b - c.
+ * The result has the power law degree distribution, the self loops and
+ * duplicate edges are kept.
+ *
+ * @param scale The vertex number is 2^scale.
+ * @param num_edges The edge number.
+ * @param edges The generated edges.
+ * @param a The probability of the top left quadrant.
+ * @param b The probability of the top right quadrant.
+ * @param c The probability of the bottom left quadrant.
+ */
+void GraphGenerator::rmat(int scale, int64_t num_edges,
+                          Vector<GraphEdge>* edges, double a, double b,
+                          double c) {
+  edges->resize(num_edges);
+  GraphEdge* data = edges->data();
+  int64_t num_blocks = (num_edges + kBlockSize - 1) / kBlockSize;
+  uint64_t seed = _seed;
+  int max_weight = _max_weight;
+  double ab = a + b;
+  double abc = a + b + c;
+
+  parallelFor(num_blocks, _num_threads, [=](int, size_t begin, size_t end) {
+    for (size_t block = begin; block < end; ++block) {
+      RandomEngine engine = blockEngine(seed, block);
+      int64_t last = std::min<int64_t>(num_edges, (block + 1) * kBlockSize);
+      for (int64_t i = block * kBlockSize; i < last; ++i) {
+        int tail = 0;
+        int head = 0;
+        for (int level = 0; level < scale; ++level) {
+          double r = absl::Uniform(engine, 0.0, 1.0);
+          tail <<= 1;
+          head <<= 1;
+          if (r >= abc) {
+            tail |= 1;
+            head |= 1;
+          } else if (r >= ab) {
+            tail |= 1;
+          } else if (r >= a) {
+            head |= 1;
+          }
+        }
+        int weight = absl::Uniform(absl::IntervalClosed, engine, 1, max_weight);
+        data[i] = {tail, head, weight};
+      }
+    }
+  });
+}
+
+/**
+ * @brief Generate the layered DAG like the combinational logic between
+ * registers.The vertex id of index i in layer l is l * layer_width + i, each
+ * vertex drives the power law fanout sinks in the next max_layer_span layers.
+ *
+ * @param num_layers The layer number.
+ * @param layer_width The vertex number of each layer.
+ * @param rent_exponent The rent exponent for the fanout distribution.
+ * @param edges The generated edges.
+ * @param max_layer_span The max layer distance of the edge.
+ * @param max_fanout The max fanout of the vertex.
+ */
+void GraphGenerator::layeredDag(int num_layers, int layer_width,
+                                double rent_exponent, Vector<GraphEdge>* edges,
+                                int max_layer_span, int max_fanout) {
+  int64_t num_drivers = static_cast<int64_t>(num_layers - 1) * layer_width;
+  if (num_drivers <= 0) {
+    edges->clear();
+    return;
+  }
+  int64_t num_blocks = (num_drivers + kBlockSize - 1) / kBlockSize;
+  uint64_t seed = _seed;
+  int max_weight = _max_weight;
+  double q = rentFanoutExponent(rent_exponent);
+  max_layer_span = std::max(1, max_layer_span);
+  max_fanout = std::max(1, max_fanout);
+
+  generateBlocks(
+      num_blocks, _num_threads, edges,
+      [=](int64_t block, std::vector<GraphEdge>* output) {
+        RandomEngine engine = blockEngine(seed, block);
+        int64_t last = std::min(num_drivers, (block + 1) * kBlockSize);
+        for (int64_t v = block * kBlockSize; v < last; ++v) {
+          int layer = static_cast<int>(v / layer_width);
+          int span = std::min(max_layer_span, num_layers - 1 - layer);
+          int fanout = 1 + absl::Zipf(engine, max_fanout - 1, q, 1.0);
+          for (int i = 0; i < fanout; ++i) {
+            int sink_layer =
+                layer + absl::Uniform(absl::IntervalClosed, engine, 1, span);
+            int sink = absl::Uniform(engine, 0, layer_width);
+            int weight =
+                absl::Uniform(absl::IntervalClosed, engine, 1, max_weight);
+            output->push_back({static_cast<int>(v),
+                               sink_layer * layer_width + sink, weight});
+          }
+        }
+      });
+}
+
+/**
+ * @brief Generate the random hypergraph like the netlist, the net degree
+ * follows the power law distribution and the pins of each net are distinct.
+ *
+ * @param num_vertexes The vertex number.
+ * @param num_nets The net number.
+ * @param rent_exponent The rent exponent for the net degree distribution.
+ * @param net_offsets The pins of net i is pins[net_offsets[i],
+ * net_offsets[i + 1]).
+ * @param pins The pins of all nets.
+ * @param max_net_degree The max pin number of the net.
+ */
+void GraphGenerator::hypergraph(int num_vertexes, int num_nets,
+                                double rent_exponent, Vector<int>* net_offsets,
+                                Vector<int>* pins, int max_net_degree) {
+  net_offsets->assign(1, 0);
+  pins->clear();
+  if (num_nets <= 0 || num_vertexes <= 0) {
+    return;
+  }
+  int64_t num_blocks = (num_nets + kBlockSize - 1) / kBlockSize;
+  uint64_t seed = _seed;
+  double q = rentFanoutExponent(rent_exponent);
+  int max_degree = std::max(1, std::min(max_net_degree, num_vertexes));
+  int min_degree = std::min(2, max_degree);
+
+  // The degree of each net is generated before the pins in the same block.
+  Vector<int> degrees;
+  generateBlocks(
+      num_blocks, _num_threads, &degrees,
+      [=](int64_t block, std::vector<int>* output) {
+        RandomEngine engine = blockEngine(seed, block);
+        int64_t last = std::min<int64_t>(num_nets, (block + 1) * kBlockSize);
+        for (int64_t net = block * kBlockSize; net < last; ++net) {
+          output->push_back(min_degree + absl::Zipf(engine,
+                                                    max_degree - min_degree,
+                                                    q, 1.0));
+        }
+      });
+
+  net_offsets->resize(num_nets + 1);
+  for (int net = 0; net < num_nets; ++net) {
+    (*net_offsets)[net + 1] = (*net_offsets)[net] + degrees[net];
+  }
+  pins->resize((*net_offsets)[num_nets]);
+  const int* offsets = net_offsets->data();
+  int* pin_data = pins->data();
+
+  parallelFor(num_blocks, _num_threads, [=](int, size_t begin, size_t end) {
+    for (size_t block = begin; block < end; ++block) {
+      RandomEngine engine = blockEngine(seed, num_blocks + block);
+      int64_t last = std::min<int64_t>(num_nets, (block + 1) * kBlockSize);
+      for (int64_t net = block * kBlockSize; net < last; ++net) {
+        int* first = pin_data + offsets[net];
+        int* end_pin = pin_data + offsets[net + 1];
+        for (int* pin = first; pin != end_pin; ++pin) {
+          do {
+            *pin = absl::Uniform(engine, 0, num_vertexes);
+          } while (std::find(first, pin, *pin) != pin);
+        }
+      }
+    }
+  });
+}
+
+/**
+ * @brief Convert the hypergraph to the edges by the star model, the first pin
+ * of the net is the driver and the other pins are the sinks.
+ *
+ * @param net_offsets The net offsets of the hypergraph, each net has at least
+ * one pin.
+ * @param pins The pins of the hypergraph.
+ * @param edges The edges from the driver to the sinks, the weight is 1.
+ */
+void GraphGenerator::hypergraphToEdges(const Vector<int>& net_offsets,
+                                       const Vector<int>& pins,
+                                       Vector<GraphEdge>* edges) {
+  size_t num_nets = net_offsets.empty() ? 0 : net_offsets.size() - 1;
+  edges->resize(num_nets == 0 ? 0 : net_offsets[num_nets] - num_nets);
+  const int* offsets = net_offsets.data();
+  const int* pin_data = pins.data();
+  GraphEdge* data = edges->data();
+
+  parallelFor(num_nets, 0, [=](int, size_t begin, size_t end) {
+    for (size_t net = begin; net < end; ++net) {
+      GraphEdge* edge = data + offsets[net] - net;
+      int driver = pin_data[offsets[net]];
+      for (int i = offsets[net] + 1; i < offsets[net + 1]; ++i) {
+        *edge++ = {driver, pin_data[i], 1};
+      }
+    }
+  });
+}
+
+}  // namespace pcl
@@ -0,0 +1,63 @@
+/**
+ * @file GraphGenerator.h
+ * @author simin tao (taosm@pcl.ac.cn)
+ * @brief The synthetic netlist like graph generator for scale test.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020 PCL EDA
+ *
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "AdjListGraphV.h"
+#include "Vector.h"
+
+namespace pcl {
+
+/**
+ * @brief The generator of large synthetic graphs.
+ *
+ * The work is split into fixed size blocks, each block has its own random
+ * engine seeded by (seed, block index), and the blocks are generated in
+ * parallel.So the result only depends on the seed and the parameters, not on
+ * the thread number.The edge list can be loaded to pcl::Graph by
+ * Graph::insertEdges.
+ */
+class GraphGenerator {
+ public:
+  explicit GraphGenerator(uint64_t seed, int num_threads = 0)
+      : _seed(seed), _num_threads(num_threads) {}
+  ~GraphGenerator() = default;
+
+  void setMaxWeight(int max_weight) { _max_weight = max_weight; }
+
+  void rmat(int scale, int64_t num_edges, Vector<GraphEdge>* edges,
+            double a = 0.57, double b = 0.19, double c = 0.19);
+
+  void layeredDag(int num_layers, int layer_width, double rent_exponent,
+                  Vector<GraphEdge>* edges, int max_layer_span = 2,
+                  int max_fanout = 64);
+
+  void hypergraph(int num_vertexes, int num_nets, double rent_exponent,
+                  Vector<int>* net_offsets, Vector<int>* pins,
+                  int max_net_degree = 256);
+
+  static void hypergraphToEdges(const Vector<int>& net_offsets,
+                                const Vector<int>& pins,
+                                Vector<GraphEdge>* edges);
+
+  static double rentFanoutExponent(double rent_exponent);
+
+ private:
+  static constexpr int64_t kBlockSize = 1 << 16;
+
+  uint64_t _seed;
+  int _num_threads;
+  int _max_weight = 100;
+};
+
+}  // namespace pcl
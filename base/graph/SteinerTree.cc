@@ -0,0 +1,272 @@
+/**
+ * @file SteinerTree.cc
+ * @author simin tao (taosm@pcl.ac.cn)
+ * @brief The implemention of net wirelength estimator.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020 PCL EDA
+ *
+ */
+
+#include "SteinerTree.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "Parallel.h"
+
+namespace pcl {
+
+/**
+ * @brief Calculate the half perimeter wirelength of the pins.
+ *
+ * @param points The pin locations.
+ * @param num_points The pin number.
+ * @return int64_t The bounding box half perimeter.
+ */
+int64_t SteinerTree::hpwl(const Point* points, int num_points) {
+  if (num_points <= 1) {
+    return 0;
+  }
+  int min_x = points[0].x;
+  int max_x = points[0].x;
+  int min_y = points[0].y;
+  int max_y = points[0].y;
+  for (int i = 1; i < num_points; ++i) {
+    min_x = std::min(min_x, points[i].x);
+    max_x = std::max(max_x, points[i].x);
+    min_y = std::min(min_y, points[i].y);
+    max_y = std::max(max_y, points[i].y);
+  }
+  return (static_cast<int64_t>(max_x) - min_x) +
+         (static_cast<int64_t>(max_y) - min_y);
+}
+
+/**
+ * @brief Build the rectilinear minimum spanning tree by Prim algorithm.
+ *
+ * The tree is stored in workspace->parent, the root is pin 0 whose parent is
+ * -1, the tree edge of pin i is (i, parent[i]), and workspace->dist[i] is the
+ * edge length.
+ *
+ * @param points The pin locations.
+ * @param num_points The pin number.
+ * @param workspace The scratch buffer.
+ */
+void SteinerTree::buildMST(const Point* points, int num_points,
+                           WirelengthWorkspace* workspace) {
+  auto& dist = workspace->dist;
+  auto& parent = workspace->parent;
+  dist.assign(num_points, std::numeric_limits<int64_t>::max());
+  parent.assign(num_points, -1);
+  if (num_points == 0) {
+    return;
+  }
+
+  // The vertex not in tree yet is kept in the front of remain, so the inner
+  // loop only scans the remained vertexes.
+  auto& remain = workspace->adj;
+  remain.resize(num_points);
+  for (int i = 0; i < num_points; ++i) {
+    remain[i] = i;
+  }
+
+  int num_remain = num_points - 1;
+  int curr = 0;
+  dist[0] = 0;
+  std::swap(remain[0], remain[num_remain]);
+  while (num_remain > 0) {
+    int best_pos = 0;
+    int64_t best_dist = std::numeric_limits<int64_t>::max();
+    for (int pos = 0; pos < num_remain; ++pos) {
+      int v = remain[pos];
+      int64_t d = distance(points[curr], points[v]);
+      if (d < dist[v]) {
+        dist[v] = d;
+        parent[v] = curr;
+      }
+      if (dist[v] < best_dist) {
+        best_dist = dist[v];
+        best_pos = pos;
+      }
+    }
+    curr = remain[best_pos];
+    --num_remain;
+    std::swap(remain[best_pos], remain[num_remain]);
+  }
+}
+
+/**
+ * @brief Calculate the rectilinear minimum spanning tree wirelength.
+ *
+ * @param points The pin locations.
+ * @param num_points The pin number.
+ * @param workspace The scratch buffer.
+ * @return int64_t The tree wirelength.
+ */
+int64_t SteinerTree::mstWirelength(const Point* points, int num_points,
+                                   WirelengthWorkspace* workspace) {
+  if (num_points <= 1) {
+    return 0;
+  } else if (num_points == 2) {
+    return distance(points[0], points[1]);
+  }
+
+  buildMST(points, num_points, workspace);
+  int64_t wirelength = 0;
+  for (int i = 1; i < num_points; ++i) {
+    wirelength += workspace->dist[i];
+  }
+  return wirelength;
+}
+
+/**
+ * @brief Calculate the approximate rectilinear steiner tree wirelength.
+ *
+ * @param points The pin locations.
+ * @param num_points The pin number.
+ * @param workspace The scratch buffer.
+ * @return int64_t The tree wirelength.
+ */
+int64_t SteinerTree::steinerWirelength(const Point* points, int num_points,
+                                       WirelengthWorkspace* workspace) {
+  if (num_points <= 3) {
+    return hpwl(points, num_points);
+  }
+
+  int64_t wirelength = mstWirelength(points, num_points, workspace);
+  const auto& parent = workspace->parent;
+
+  // build the tree adjacency in csr format.
+  auto& adj_offset = workspace->adj_offset;
+  auto& adj = workspace->adj;
+  adj_offset.assign(num_points + 1, 0);
+  for (int v = 1; v < num_points; ++v) {
+    ++adj_offset[v + 1];
+    ++adj_offset[parent[v] + 1];
+  }
+  for (int v = 0; v < num_points; ++v) {
+    adj_offset[v + 1] += adj_offset[v];
+  }
+  adj.resize(adj_offset[num_points]);
+  auto& fill = workspace->dist;
+  fill.assign(adj_offset.begin(), adj_offset.end() - 1);
+  for (int v = 1; v < num_points; ++v) {
+    adj[fill[v]++] = parent[v];
+    adj[fill[parent[v]]++] = v;
+  }
+
+  // The tree edge (u, v) is identified by the child vertex.
+  auto edge_id = [&parent](int u, int v) { return parent[v] == u ? v : u; };
+
+  auto& candidates = workspace->candidates;
+  candidates.clear();
+  for (int u = 0; u < num_points; ++u) {
+    for (int i = adj_offset[u]; i < adj_offset[u + 1]; ++i) {
+      int v = adj[i];
+      int64_t uv = distance(points[u], points[v]);
+      for (int j = i + 1; j < adj_offset[u + 1]; ++j) {
+        int w = adj[j];
+        Point triple[3] = {points[u], points[v], points[w]};
+        int64_t gain = uv + distance(points[u], points[w]) - hpwl(triple, 3);
+        if (gain > 0) {
+          candidates.push_back({gain, edge_id(u, v), edge_id(u, w)});
+        }
+      }
+    }
+  }
+
+  std::sort(candidates.begin(), candidates.end(),
+            [](const WirelengthWorkspace::Candidate& c1,
+               const WirelengthWorkspace::Candidate& c2) {
+              return c1.gain > c2.gain;
+            });
+  auto& used = workspace->used;
+  used.assign(num_points, 0);
+  for (const auto& c : candidates) {
+    if (!used[c.edge1] && !used[c.edge2]) {
+      used[c.edge1] = 1;
+      used[c.edge2] = 1;
+      wirelength -= c.gain;
+    }
+  }
+
+  return wirelength;
+}
+
+/**
+ * @brief Calculate the net wirelength of the model.
+ *
+ * @param points The pin locations.
+ * @param num_points The pin number.
+ * @param model The wirelength model.
+ * @param workspace The scratch buffer.
+ * @return int64_t The net wirelength.
+ */
+int64_t SteinerTree::wirelength(const Point* points, int num_points,
+                                WirelengthModel model,
+                                WirelengthWorkspace* workspace) {
+  switch (model) {
+    case WirelengthModel::kHPWL:
+      return hpwl(points, num_points);
+    case WirelengthModel::kMST:
+      return mstWirelength(points, num_points, workspace);
+    case WirelengthModel::kSteiner:
+      return steinerWirelength(points, num_points, workspace);
+  }
+  return 0;
+}
+
+int64_t SteinerTree::hpwl(const Vector<Point>& points) {
+  return hpwl(points.data(), static_cast<int>(points.size()));
+}
+
+int64_t SteinerTree::mstWirelength(const Vector<Point>& points) {
+  WirelengthWorkspace workspace;
+  return mstWirelength(points.data(), static_cast<int>(points.size()),
+                       &workspace);
+}
+
+int64_t SteinerTree::steinerWirelength(const Vector<Point>& points) {
+  WirelengthWorkspace workspace;
+  return steinerWirelength(points.data(), static_cast<int>(points.size()),
+                           &workspace);
+}
+
+/**
+ * @brief Calculate the wirelength of many nets in parallel.
+ *
+ * The pins of all nets are stored in one vector, the pins of net i are
+ * points[net_offsets[i], net_offsets[i + 1]), so there are
+ * net_offsets.size() - 1 nets.
+ *
+ * @param points The pin locations of all nets.
+ * @param net_offsets The pin offset of each net.
+ * @param model The wirelength model.
+ * @param result The wirelength of each net.
+ * @param num_threads The thread number, zero means the hardware concurrency.
+ */
+void SteinerTree::batchWirelength(const Vector<Point>& points,
+                                  const Vector<int>& net_offsets,
+                                  WirelengthModel model,
+                                  Vector<int64_t>* result, int num_threads) {
+  size_t num_nets = net_offsets.empty() ? 0 : net_offsets.size() - 1;
+  result->resize(num_nets);
+  const Point* pins = points.data();
+  const int* offsets = net_offsets.data();
+  int64_t* wirelengths = result->data();
+
+  parallelFor(num_nets, num_threads,
+              [pins, offsets, wirelengths, model](int, size_t begin,
+                                                  size_t end) {
+                WirelengthWorkspace workspace;
+                for (size_t i = begin; i < end; ++i) {
+                  wirelengths[i] =
+                      wirelength(pins + offsets[i], offsets[i + 1] - offsets[i],
+                                 model, &workspace);
+                }
+              });
+}
+
+}  // namespace pcl
@@ -0,0 +1,98 @@
+/**
+ * @file SteinerTree.h
+ * @author simin tao (taosm@pcl.ac.cn)
+ * @brief The net wirelength estimator based on rectilinear minimum spanning
+ * tree and steiner tree.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020 PCL EDA
+ *
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Vector.h"
+
+namespace pcl {
+
+/**
+ * @brief The pin location of a net.
+ *
+ */
+struct Point {
+  int x;
+  int y;
+};
+
+/**
+ * @brief The wirelength model of a net.
+ *
+ */
+enum class WirelengthModel : int { kHPWL = 0, kMST = 1, kSteiner = 2 };
+
+/**
+ * @brief The scratch buffer of the wirelength estimator.
+ *
+ * The estimator is called in the inner loop of placer, so the buffer is reused
+ * between nets to avoid malloc, each thread should own one workspace.
+ */
+struct WirelengthWorkspace {
+  struct Candidate {
+    int64_t gain;
+    int edge1;
+    int edge2;
+  };
+
+  std::vector<int64_t> dist;
+  std::vector<int> parent;
+  std::vector<int> adj_offset;
+  std::vector<int> adj;
+  std::vector<Candidate> candidates;
+  std::vector<char> used;
+};
+
+/**
+ * @brief The rectilinear tree estimator for net wirelength.
+ *
+ * The MST is built by Prim algorithm in O(n^2), which is faster than the heap
+ * version for the pin number of common nets.The steiner tree is approximated
+ * from the MST, for each tree vertex and two adjacent tree edges, the two
+ * edges are replaced by the optimal three pin steiner tree at the median
+ * point, the non-conflict replacements are accepted greedily by gain.Nets of
+ * at most three pins use the exact half perimeter wirelength.
+ */
+class SteinerTree {
+ public:
+  static int64_t distance(const Point& p1, const Point& p2) {
+    int64_t dx = static_cast<int64_t>(p1.x) - p2.x;
+    int64_t dy = static_cast<int64_t>(p1.y) - p2.y;
+    return (dx < 0 ? -dx : dx) + (dy < 0 ? -dy : dy);
+  }
+
+  static int64_t hpwl(const Point* points, int num_points);
+  static int64_t mstWirelength(const Point* points, int num_points,
+                               WirelengthWorkspace* workspace);
+  static int64_t steinerWirelength(const Point* points, int num_points,
+                                   WirelengthWorkspace* workspace);
+  static int64_t wirelength(const Point* points, int num_points,
+                            WirelengthModel model,
+                            WirelengthWorkspace* workspace);
+
+  static int64_t hpwl(const Vector<Point>& points);
+  static int64_t mstWirelength(const Vector<Point>& points);
+  static int64_t steinerWirelength(const Vector<Point>& points);
+
+  static void buildMST(const Point* points, int num_points,
+                       WirelengthWorkspace* workspace);
+
+  static void batchWirelength(const Vector<Point>& points,
+                              const Vector<int>& net_offsets,
+                              WirelengthModel model, Vector<int64_t>* result,
+                              int num_threads = 0);
+};
+
+}  // namespace pcl
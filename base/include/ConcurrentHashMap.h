@@ -0,0 +1,313 @@
+/**
+ * @file ConcurrentHashMap.h
+ * @author simin tao (taosm@pcl.ac.cn)
+ * @brief The thread safe hash map container for the eda project.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include "Parallel.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+
+namespace pcl {
+
+/**
+ * @brief A thread safe hash map made up of unique key.
+ *
+ * The keys are split into power of two shards by the high bits of the key
+ * hash, each shard is a flat hash map guarded by its own reader writer
+ * mutex.The lookups of one shard run concurrently under the reader lock, and
+ * the threads only contend when they write the same shard, so the lookup
+ * throughput scales with the cores.The hash is computed once and reused for
+ * the lookup inside the shard.
+ *
+ * Each operation on one key is atomic.The iterator and reference are not
+ * exposed because they would outlive the lock, so the value is copied out, or
+ * accessed in the callback of visit and compute under the shard lock.The
+ * callback should be short and must not access the same map, otherwise it may
+ * dead lock.
+ *
+ * @tparam KEY Type of key.
+ * @tparam VALUE Type of value.
+ */
+template <class KEY, class VALUE,
+          class HASH = typename absl::flat_hash_map<KEY, VALUE>::hasher,
+          class EQ = typename absl::flat_hash_map<KEY, VALUE>::key_equal>
+class ConcurrentHashMap {
+ public:
+  using Shard = absl::flat_hash_map<KEY, VALUE, HASH, EQ>;
+  using key_type = KEY;
+  using mapped_type = VALUE;
+  using hasher = HASH;
+  using key_equal = EQ;
+  // The key type of heterogeneous lookup, it is K when the hash and eq are
+  // transparent, otherwise KEY.
+  template <class K>
+  using key_arg = typename Shard::template key_arg<K>;
+
+  /**
+   * @brief Construct the map.
+   *
+   * @param num_shards The shard number, rounded up to the power of two, zero
+   * means four times of the hardware concurrency.
+   */
+  explicit ConcurrentHashMap(size_t num_shards = 0) {
+    if (num_shards == 0) {
+      num_shards = static_cast<size_t>(defaultThreadNum()) * 4;
+    }
+    _shard_bits = 0;
+    while ((static_cast<size_t>(1) << _shard_bits) < num_shards &&
+           _shard_bits < kMaxShardBits) {
+      ++_shard_bits;
+    }
+    _shards.reset(new LockedShard[numShards()]);
+  }
+  ~ConcurrentHashMap() = default;
+
+  ConcurrentHashMap(const ConcurrentHashMap&) = delete;
+  ConcurrentHashMap& operator=(const ConcurrentHashMap&) = delete;
+
+  size_t numShards() const { return static_cast<size_t>(1) << _shard_bits; }
+
+  /**
+   * @brief Get the element number, the result is not a snapshot when other
+   * threads are writing.
+   *
+   * @return size_t The element number.
+   */
+  size_t size() const {
+    size_t num = 0;
+    for (size_t i = 0; i < numShards(); ++i) {
+      absl::ReaderMutexLock lock(&_shards[i].mutex);
+      num += _shards[i].map.size();
+    }
+    return num;
+  }
+
+  bool empty() const { return size() == 0; }
+
+  void clear() {
+    for (size_t i = 0; i < numShards(); ++i) {
+      absl::WriterMutexLock lock(&_shards[i].mutex);
+      _shards[i].map.clear();
+    }
+  }
+
+  /**
+   * @brief Reserve the space of total num elements, spread over the shards.
+   *
+   * @param num The expected element number.
+   */
+  void reserve(size_t num) {
+    size_t shard_num = (num + numShards() - 1) / numShards();
+    for (size_t i = 0; i < numShards(); ++i) {
+      absl::WriterMutexLock lock(&_shards[i].mutex);
+      _shards[i].map.reserve(shard_num);
+    }
+  }
+
+  /**
+   * @brief Find the value of the key and copy it out.
+   *
+   * @param key
+   * @param value The found value, unchanged if not found.
+   * @return true if find out.
+   * @return false
+   */
+  template <class K = KEY>
+  bool find(const key_arg<K>& key, VALUE* value) const {
+    return visit(key, [value](const VALUE& found) { *value = found; });
+  }
+
+  /**
+   * @brief Find out if key is in the map.
+   *
+   * @param key
+   * @return true if find out.
+   * @return false
+   */
+  template <class K = KEY>
+  bool hasKey(const key_arg<K>& key) const {
+    return visit(key, [](const VALUE&) {});
+  }
+
+  /**
+   * @brief Find the value corresponding to the key.
+   *
+   * @param key
+   * @param default_value The default return value if not found.
+   * @return const VALUE Return the found value.
+   */
+  template <class K = KEY>
+  const VALUE value(const key_arg<K>& key,
+                    const VALUE& default_value = VALUE()) const {
+    VALUE ret_value = default_value;
+    find(key, &ret_value);
+    return ret_value;
+  }
+
+  /**
+   * @brief Call func(const VALUE&) on the value of the key under the reader
+   * lock, the value is not copied.
+   *
+   * @return true if the key is found.
+   * @return false
+   */
+  template <typename FUNC, class K = KEY>
+  bool visit(const key_arg<K>& key, FUNC&& func) const {
+    size_t hash = _hash(key);
+    const LockedShard& shard = _shards[shardIndex(hash)];
+    absl::ReaderMutexLock lock(&shard.mutex);
+    auto find_iter = shard.map.find(key, hash);
+    if (find_iter == shard.map.end()) {
+      return false;
+    }
+    func(static_cast<const VALUE&>(find_iter->second));
+    return true;
+  }
+
+  /**
+   * @brief Insert the (key, value) if the key is not in the map, the existed
+   * value is kept.
+   *
+   * @param key
+   * @param value
+   * @return true if inserted.
+   * @return false if the key is existed.
+   */
+  bool insert(const KEY& key, const VALUE& value) {
+    LockedShard& shard = _shards[shardIndex(_hash(key))];
+    absl::WriterMutexLock lock(&shard.mutex);
+    return shard.map.try_emplace(key, value).second;
+  }
+
+  bool insert(KEY&& key, VALUE&& value) {
+    LockedShard& shard = _shards[shardIndex(_hash(key))];
+    absl::WriterMutexLock lock(&shard.mutex);
+    return shard.map.try_emplace(std::move(key), std::move(value)).second;
+  }
+
+  /**
+   * @brief Insert the (key, value), or assign the value if the key is existed.
+   *
+   * @param key
+   * @param value
+   * @return true if inserted.
+   * @return false if assigned.
+   */
+  bool upsert(const KEY& key, const VALUE& value) {
+    LockedShard& shard = _shards[shardIndex(_hash(key))];
+    absl::WriterMutexLock lock(&shard.mutex);
+    return shard.map.insert_or_assign(key, value).second;
+  }
+
+  bool upsert(KEY&& key, VALUE&& value) {
+    LockedShard& shard = _shards[shardIndex(_hash(key))];
+    absl::WriterMutexLock lock(&shard.mutex);
+    return shard.map.insert_or_assign(std::move(key), std::move(value)).second;
+  }
+
+  /**
+   * @brief Update the value of the key atomically by func(VALUE& value, bool
+   * inserted) under the writer lock, the value is default constructed if the
+   * key is not in the map.
+   *
+   * ConcurrentHashMap<std::string, int> counter;
+   * counter.compute(word, [](int& count, bool) { ++count; });
+   *
+   * @return true if the key is inserted.
+   * @return false
+   */
+  template <typename FUNC>
+  bool compute(const KEY& key, FUNC&& func) {
+    LockedShard& shard = _shards[shardIndex(_hash(key))];
+    absl::WriterMutexLock lock(&shard.mutex);
+    auto result = shard.map.try_emplace(key);
+    func(result.first->second, result.second);
+    return result.second;
+  }
+
+  /**
+   * @brief Update the value of the key by func(VALUE& value) under the writer
+   * lock only if the key is in the map.
+   *
+   * @return true if the key is found.
+   * @return false
+   */
+  template <typename FUNC, class K = KEY>
+  bool computeIfPresent(const key_arg<K>& key, FUNC&& func) {
+    size_t hash = _hash(key);
+    LockedShard& shard = _shards[shardIndex(hash)];
+    absl::WriterMutexLock lock(&shard.mutex);
+    auto find_iter = shard.map.find(key, hash);
+    if (find_iter == shard.map.end()) {
+      return false;
+    }
+    func(find_iter->second);
+    return true;
+  }
+
+  /**
+   * @brief Erase the key.
+   *
+   * @param key
+   * @return true if erased.
+   * @return false if the key is not found.
+   */
+  template <class K = KEY>
+  bool erase(const key_arg<K>& key) {
+    LockedShard& shard = _shards[shardIndex(_hash(key))];
+    absl::WriterMutexLock lock(&shard.mutex);
+    return shard.map.erase(key) != 0;
+  }
+
+  /**
+   * @brief Call func(const KEY&, const VALUE&) on each element, one shard is
+   * locked at a time, so the elements written by other threads concurrently
+   * may be missed.
+   */
+  template <typename FUNC>
+  void forEach(FUNC&& func) const {
+    for (size_t i = 0; i < numShards(); ++i) {
+      absl::ReaderMutexLock lock(&_shards[i].mutex);
+      for (const auto& p : _shards[i].map) {
+        func(p.first, p.second);
+      }
+    }
+  }
+
+ private:
+  static constexpr int kMaxShardBits = 16;
+
+  // The shard is cache line aligned to avoid the false sharing of the mutex.
+  struct alignas(64) LockedShard {
+    mutable absl::Mutex mutex;
+    Shard map;
+  };
+
+  // The low bits of the hash are used by the flat hash map to locate the slot,
+  // so the shard is chosen by the high bits to keep the slots of each shard
+  // well distributed.
+  size_t shardIndex(size_t hash) const {
+    uint64_t mixed = static_cast<uint64_t>(hash) * 0x9E3779B97F4A7C15ull;
+    return _shard_bits == 0 ? 0
+                            : static_cast<size_t>(mixed >> (64 - _shard_bits));
+  }
+
+  HASH _hash;
+  int _shard_bits;
+  std::unique_ptr<LockedShard[]> _shards;
+};
+
+}  // namespace pcl
@@ -0,0 +1,218 @@
+/**
+ * @file ContainerStats.h
+ * @author simin tao (taosm@pcl.ac.cn)
+ * @brief The hash table health statistics of the containers for the eda
+ * project.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "HashTableStats.h"
+#include "absl/synchronization/mutex.h"
+
+namespace pcl {
+
+/**
+ * @brief The report of the hash table health of the process.
+ *
+ * Only the tables registered by track are reported, each one is scanned
+ * when the report is collected.The vendored abseil compiles the hashtablez
+ * sampler out, so the tables not tracked, their allocation sites, tombstones
+ * and rehashes can not be reported.
+ *
+ * Nothing is enabled by itself, the program calls dumpAtExit or initFromEnv
+ * explicitly.
+ *
+ * auto tracker = ContainerStats::instance().track("net map", &net_map);
+ * ...
+ * ContainerStats::instance().dump(std::cerr);
+ */
+class ContainerStats {
+ public:
+  using Collector = std::function<HashTableStats()>;
+
+  /**
+   * @brief The RAII registration of a tracked table, the table must outlive
+   * the tracker.
+   */
+  class Tracker {
+   public:
+    Tracker() = default;
+    explicit Tracker(int64_t id) : _id(id) {}
+    ~Tracker() { reset(); }
+    Tracker(Tracker&& other) noexcept : _id(other._id) { other._id = -1; }
+    Tracker& operator=(Tracker&& other) noexcept {
+      if (this != &other) {
+        reset();
+        _id = other._id;
+        other._id = -1;
+      }
+      return *this;
+    }
+    Tracker(const Tracker&) = delete;
+    Tracker& operator=(const Tracker&) = delete;
+
+    void reset() {
+      if (_id >= 0) {
+        ContainerStats::instance().untrack(_id);
+        _id = -1;
+      }
+    }
+
+   private:
+    int64_t _id = -1;
+  };
+
+  static ContainerStats& instance() {
+    static ContainerStats stats;
+    return stats;
+  }
+
+  /**
+   * @brief Register the table, it is scanned at every report until the
+   * tracker is destroyed.
+   *
+   * @param site The name of the table in the report.
+   * @param table
+   * @return Tracker
+   */
+  template <class TABLE>
+  [[nodiscard]] Tracker track(const std::string& site, const TABLE* table) {
+    return Tracker(registerCollector(
+        [site, table]() { return hashTableStats(*table, site); }));
+  }
+
+  /**
+   * @brief Register a custom collector, return the id for untrack.
+   */
+  int64_t registerCollector(Collector collector) {
+    absl::MutexLock lock(&_mutex);
+    _collectors.emplace(_next_id, std::move(collector));
+    return _next_id++;
+  }
+
+  void untrack(int64_t id) {
+    absl::MutexLock lock(&_mutex);
+    _collectors.erase(id);
+  }
+
+  /**
+   * @brief Collect the statistics of the tracked tables, the worst probed
+   * tables come first.
+   *
+   * @return std::vector<HashTableStats>
+   */
+  std::vector<HashTableStats> collect() const {
+    std::vector<HashTableStats> all_stats;
+    {
+      absl::MutexLock lock(&_mutex);
+      for (const auto& p : _collectors) {
+        all_stats.push_back(p.second());
+      }
+    }
+    std::stable_sort(all_stats.begin(), all_stats.end(),
+                     [](const HashTableStats& a, const HashTableStats& b) {
+                       return a.max_probe_length > b.max_probe_length;
+                     });
+    return all_stats;
+  }
+
+  /**
+   * @brief Write the report, one line per table.
+   *
+   * @param out
+   */
+  void dump(std::ostream& out) const {
+    std::vector<HashTableStats> all_stats = collect();
+    out << "# pcl container stats: " << all_stats.size() << " hash tables\n";
+    out << "# size capacity load max_probe mean_probe site\n";
+    for (const auto& stats : all_stats) {
+      out << stats.size << ' ' << stats.capacity << ' ' << std::fixed
+          << std::setprecision(3) << stats.loadFactor() << ' '
+          << stats.max_probe_length << ' ' << stats.meanProbeLength() << ' '
+          << (stats.site.empty() ? "?" : stats.site) << '\n';
+    }
+    out << std::defaultfloat;
+  }
+
+  /**
+   * @brief Dump the report to the file at exit, "stderr" means the standard
+   * error.Only the last file takes effect if called again.
+   *
+   * @param file_name
+   */
+  void dumpAtExit(const std::string& file_name) {
+    {
+      absl::MutexLock lock(&_mutex);
+      _exit_file = file_name;
+      if (_exit_registered) {
+        return;
+      }
+      _exit_registered = true;
+    }
+    std::atexit([]() { ContainerStats::instance().dumpExitFile(); });
+  }
+
+  /**
+   * @brief Read PCL_CONTAINER_STATS, turn on the dump of the tracked tables
+   * at exit if it is set.It is not called by itself, the program calls it at
+   * the start of main.
+   *
+   * @return true if enabled.
+   * @return false
+   */
+  bool initFromEnv() {
+    const char* file_name = std::getenv("PCL_CONTAINER_STATS");
+    if (file_name == nullptr || *file_name == '\0') {
+      return false;
+    }
+    dumpAtExit(file_name);
+    return true;
+  }
+
+ private:
+  ContainerStats() = default;
+  ~ContainerStats() = default;
+
+  void dumpExitFile() const {
+    std::string file_name;
+    {
+      absl::MutexLock lock(&_mutex);
+      file_name = _exit_file;
+    }
+    if (file_name == "stderr") {
+      dump(std::cerr);
+      return;
+    }
+    std::ofstream out(file_name);
+    if (out) {
+      dump(out);
+    }
+  }
+
+  mutable absl::Mutex _mutex;
+  std::map<int64_t, Collector> _collectors;
+  int64_t _next_id = 0;
+  std::string _exit_file;
+  bool _exit_registered = false;
+};
+
+}  // namespace pcl
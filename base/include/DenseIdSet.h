@@ -0,0 +1,669 @@
+/**
+ * @file DenseIdSet.h
+ * @author simin tao (taosm@pcl.ac.cn)
+ * @brief The bitset backed set of the dense integer ids for the eda project.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+// The popcnt instruction is not enabled by the build flags, so the word
+// kernels are also compiled for popcnt and chosen by the cpu at run time.
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__)) && !defined(__POPCNT__)
+#define PCL_POPCNT_DISPATCH 1
+#else
+#define PCL_POPCNT_DISPATCH 0
+#endif
+
+// The kernel is inlined into its popcnt version even without optimization,
+// so its popcount is expanded to the instruction there.
+#if defined(__GNUC__) || defined(__clang__)
+#define PCL_ALWAYS_INLINE __attribute__((always_inline)) inline
+#else
+#define PCL_ALWAYS_INLINE inline
+#endif
+
+namespace pcl {
+
+namespace detail {
+
+/**
+ * @brief The index of the lowest set bit, the word should not be zero.
+ */
+inline int countTrailingZeros64(uint64_t word) {
+#if defined(_MSC_VER) && !defined(__clang__) && \
+    (defined(_M_X64) || defined(_M_ARM64))
+  unsigned long index;
+  _BitScanForward64(&index, word);
+  return static_cast<int>(index);
+#elif defined(_MSC_VER) && !defined(__clang__)
+  unsigned long index;
+  if (_BitScanForward(&index, static_cast<uint32_t>(word))) {
+    return static_cast<int>(index);
+  }
+  _BitScanForward(&index, static_cast<uint32_t>(word >> 32));
+  return static_cast<int>(index) + 32;
+#else
+  return __builtin_ctzll(word);
+#endif
+}
+
+/**
+ * @brief The number of the set bits.
+ */
+PCL_ALWAYS_INLINE int popcount64(uint64_t word) {
+#if defined(_MSC_VER) && !defined(__clang__)
+  // The popcnt instruction is not in every x86 cpu, so the bits are summed.
+  word -= (word >> 1) & 0x5555555555555555ull;
+  word = (word & 0x3333333333333333ull) + ((word >> 2) & 0x3333333333333333ull);
+  word = (word + (word >> 4)) & 0x0f0f0f0f0f0f0f0full;
+  return static_cast<int>((word * 0x0101010101010101ull) >> 56);
+#else
+  return __builtin_popcountll(word);
+#endif
+}
+
+/**
+ * @brief Whether the id is non negative.
+ */
+template <class ID>
+constexpr bool isValidId(ID id) {
+  if constexpr (std::is_signed<ID>::value) {
+    return id >= 0;
+  } else {
+    return true;
+  }
+}
+
+/**
+ * @brief Replace the words [0, n) by op(word, other word), return the set
+ * bit number of the new words minus that of the old words.
+ */
+template <class OP>
+PCL_ALWAYS_INLINE int64_t updateWordsKernel(uint64_t* words,
+                                            const uint64_t* other_words,
+                                            size_t n, OP op) {
+  int64_t diff = 0;
+  for (size_t i = 0; i < n; ++i) {
+    uint64_t old_word = words[i];
+    uint64_t new_word = op(old_word, other_words[i]);
+    words[i] = new_word;
+    diff += popcount64(new_word) - popcount64(old_word);
+  }
+  return diff;
+}
+
+/**
+ * @brief The set bit number of op(word, other word) of the words [0, n).
+ */
+template <class OP>
+PCL_ALWAYS_INLINE size_t countWordsKernel(const uint64_t* words,
+                                          const uint64_t* other_words,
+                                          size_t n, OP op) {
+  size_t num = 0;
+  for (size_t i = 0; i < n; ++i) {
+    num += popcount64(op(words[i], other_words[i]));
+  }
+  return num;
+}
+
+#if PCL_POPCNT_DISPATCH
+template <class OP>
+__attribute__((target("popcnt"))) int64_t updateWordsPopcnt(
+    uint64_t* words, const uint64_t* other_words, size_t n, OP op) {
+  return updateWordsKernel(words, other_words, n, op);
+}
+
+template <class OP>
+__attribute__((target("popcnt"))) size_t countWordsPopcnt(
+    const uint64_t* words, const uint64_t* other_words, size_t n, OP op) {
+  return countWordsKernel(words, other_words, n, op);
+}
+
+inline bool hasPopcnt() {
+  static const bool has_popcnt = __builtin_cpu_supports("popcnt");
+  return has_popcnt;
+}
+#endif
+
+template <class OP>
+int64_t updateWords(uint64_t* words, const uint64_t* other_words, size_t n,
+                    OP op) {
+#if PCL_POPCNT_DISPATCH
+  if (hasPopcnt()) {
+    return updateWordsPopcnt(words, other_words, n, op);
+  }
+#endif
+  return updateWordsKernel(words, other_words, n, op);
+}
+
+template <class OP>
+size_t countWords(const uint64_t* words, const uint64_t* other_words,
+                  size_t n, OP op) {
+#if PCL_POPCNT_DISPATCH
+  if (hasPopcnt()) {
+    return countWordsPopcnt(words, other_words, n, op);
+  }
+#endif
+  return countWordsKernel(words, other_words, n, op);
+}
+
+}  // namespace detail
+
+/**
+ * @brief The set of the dense non negative integer ids, such as the vertex or
+ * instance id, backed by one bit per id.
+ *
+ * Compared with the HashSet<int> or Set<int>, the set costs one bit per id of
+ * the id range instead of 8-40 bytes per element, the lookup is one bit test,
+ * and the set algebra runs word by word over the words of the other set and
+ * keeps the size by the popcount of the changed words, the popcnt instruction
+ * is chosen at run time when the build flags do not enable it.The iteration
+ * visits the set bits in ascending id order.
+ *
+ * DenseIdSet<int> fanout;
+ * fanout.insert(vertex_id);
+ * fanout &= visited;
+ * for (int id : fanout) {
+ *   ...
+ * }
+ *
+ * @tparam ID The integral id type.
+ */
+template <class ID = int>
+class DenseIdSet {
+ public:
+  static_assert(std::is_integral<ID>::value, "the id must be integral");
+  using key_type = ID;
+  using value_type = ID;
+  using size_type = size_t;
+  using Word = uint64_t;
+  static constexpr size_t kWordBits = 64;
+
+  /**
+   * @brief The iterator of the set ids in ascending order.
+   */
+  class const_iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = ID;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const ID*;
+    using reference = ID;
+
+    const_iterator() = default;
+    const_iterator(const Word* words, size_t num_words, size_t word_index)
+        : _words(words), _num_words(num_words), _word_index(word_index) {
+      if (_word_index < _num_words) {
+        _bits = _words[_word_index];
+        skipEmptyWords();
+      }
+    }
+
+    ID operator*() const {
+      return static_cast<ID>(_word_index * kWordBits +
+                             detail::countTrailingZeros64(_bits));
+    }
+    const_iterator& operator++() {
+      _bits &= _bits - 1;
+      skipEmptyWords();
+      return *this;
+    }
+    const_iterator operator++(int) {
+      const_iterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+    bool operator==(const const_iterator& o) const {
+      return _word_index == o._word_index && _bits == o._bits;
+    }
+    bool operator!=(const const_iterator& o) const { return !(*this == o); }
+
+   private:
+    void skipEmptyWords() {
+      while (_bits == 0 && ++_word_index < _num_words) {
+        _bits = _words[_word_index];
+      }
+      if (_word_index >= _num_words) {
+        _word_index = _num_words;
+        _bits = 0;
+      }
+    }
+
+    const Word* _words = nullptr;
+    size_t _num_words = 0;
+    size_t _word_index = 0;
+    Word _bits = 0;
+  };
+  using iterator = const_iterator;
+
+  DenseIdSet() = default;
+  /**
+   * @brief Construct the empty set with the id range [0, max_id) reserved.
+   */
+  explicit DenseIdSet(size_t max_id) { reserve(max_id); }
+  DenseIdSet(std::initializer_list<ID> ids) {
+    for (ID id : ids) {
+      insert(id);
+    }
+  }
+  ~DenseIdSet() = default;
+
+  DenseIdSet(const DenseIdSet&) = default;
+  DenseIdSet(DenseIdSet&&) noexcept = default;
+  DenseIdSet& operator=(const DenseIdSet&) = default;
+  DenseIdSet& operator=(DenseIdSet&&) noexcept = default;
+
+  const_iterator begin() const {
+    return const_iterator(_words.data(), _words.size(), 0);
+  }
+  const_iterator end() const {
+    return const_iterator(_words.data(), _words.size(), _words.size());
+  }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+
+  size_t size() const { return _size; }
+  bool empty() const { return _size == 0; }
+  /**
+   * @brief The id range [0, capacity()) held without growth.
+   */
+  size_t capacity() const { return _words.size() * kWordBits; }
+  void reserve(size_t max_id) {
+    size_t num_words = (max_id + kWordBits - 1) / kWordBits;
+    if (num_words > _words.size()) {
+      _words.resize(num_words, 0);
+    }
+  }
+  void clear() {
+    _words.clear();
+    _size = 0;
+  }
+  void swap(DenseIdSet& other) {
+    _words.swap(other._words);
+    std::swap(_size, other._size);
+  }
+
+  /**
+   * @brief Insert the id, the id range grows to hold it.
+   *
+   * @param id The non negative id.
+   * @return true if inserted.
+   * @return false if the id is existed or negative.
+   */
+  bool insert(ID id) {
+    if (!detail::isValidId(id)) {
+      return false;
+    }
+    size_t index = static_cast<size_t>(id);
+    reserve(index + 1);
+    Word& word = _words[index / kWordBits];
+    Word mask = Word(1) << (index % kWordBits);
+    if (word & mask) {
+      return false;
+    }
+    word |= mask;
+    ++_size;
+    return true;
+  }
+  template <class ITER>
+  void insert(ITER first, ITER last) {
+    for (; first != last; ++first) {
+      insert(*first);
+    }
+  }
+
+  /**
+   * @brief Erase the id.
+   *
+   * @param id
+   * @return size_t The erased number, zero or one.
+   */
+  size_t erase(ID id) {
+    if (!contains(id)) {
+      return 0;
+    }
+    size_t index = static_cast<size_t>(id);
+    _words[index / kWordBits] &= ~(Word(1) << (index % kWordBits));
+    --_size;
+    return 1;
+  }
+
+  bool contains(ID id) const {
+    size_t index = static_cast<size_t>(id);
+    // The negative id is cast to the huge index out of the range.
+    return index / kWordBits < _words.size() &&
+           ((_words[index / kWordBits] >> (index % kWordBits)) & 1);
+  }
+  bool hasKey(ID id) const { return contains(id); }
+  size_t count(ID id) const { return contains(id) ? 1 : 0; }
+
+  /**
+   * @brief Calculate the union of this set and the other set.
+   *
+   * @param other
+   * @return DenseIdSet<ID>& This set after unite the other.
+   */
+  DenseIdSet<ID>& unite(const DenseIdSet<ID>& other) {
+    reserve(other.capacity());
+    _size += detail::updateWords(
+        _words.data(), other._words.data(), other._words.size(),
+        [](Word word, Word other_word) { return word | other_word; });
+    return *this;
+  }
+
+  /**
+   * @brief Calculate the intersect between this and other.
+   *
+   * @param other
+   * @return DenseIdSet<ID>& This set after intersect the other.
+   */
+  DenseIdSet<ID>& intersect(const DenseIdSet<ID>& other) {
+    size_t n = std::min(_words.size(), other._words.size());
+    // The result only has the words [0, n), so the size is counted there.
+    std::fill(_words.begin() + n, _words.end(), 0);
+    _size = detail::countWords(
+        _words.data(), other._words.data(), n,
+        [](Word word, Word other_word) { return word & other_word; });
+    Word* words = _words.data();
+    const Word* other_words = other._words.data();
+    for (size_t i = 0; i < n; ++i) {
+      words[i] &= other_words[i];
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Subtract the other set from this set.
+   *
+   * @param other
+   * @return DenseIdSet<ID>& This set after subtract the other.
+   */
+  DenseIdSet<ID>& subtract(const DenseIdSet<ID>& other) {
+    size_t n = std::min(_words.size(), other._words.size());
+    _size += detail::updateWords(
+        _words.data(), other._words.data(), n,
+        [](Word word, Word other_word) { return word & ~other_word; });
+    return *this;
+  }
+
+  /**
+   * @brief Count the common ids without building the intersect set.
+   */
+  size_t intersectCount(const DenseIdSet<ID>& other) const {
+    size_t n = std::min(_words.size(), other._words.size());
+    return detail::countWords(
+        _words.data(), other._words.data(), n,
+        [](Word word, Word other_word) { return word & other_word; });
+  }
+
+  bool intersects(const DenseIdSet<ID>& other) const {
+    size_t n = std::min(_words.size(), other._words.size());
+    for (size_t i = 0; i < n; ++i) {
+      if (_words[i] & other._words[i]) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * @brief Judge whether this set is the subset of the other set.
+   */
+  bool isSubset(const DenseIdSet<ID>& other) const {
+    for (size_t i = 0; i < _words.size(); ++i) {
+      Word other_word = i < other._words.size() ? other._words[i] : 0;
+      if (_words[i] & ~other_word) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @brief Call func(ID) on each id in ascending order.
+   */
+  template <typename FUNC>
+  void forEach(FUNC&& func) const {
+    for (size_t i = 0; i < _words.size(); ++i) {
+      for (Word bits = _words[i]; bits != 0; bits &= bits - 1) {
+        func(static_cast<ID>(i * kWordBits +
+                             detail::countTrailingZeros64(bits)));
+      }
+    }
+  }
+
+  inline DenseIdSet<ID>& operator|=(const DenseIdSet<ID>& other) {
+    return unite(other);
+  }
+  inline DenseIdSet<ID>& operator|=(ID id) {
+    insert(id);
+    return *this;
+  }
+  inline DenseIdSet<ID>& operator&=(const DenseIdSet<ID>& other) {
+    return intersect(other);
+  }
+  inline DenseIdSet<ID>& operator-=(const DenseIdSet<ID>& other) {
+    return subtract(other);
+  }
+  inline DenseIdSet<ID>& operator-=(ID id) {
+    erase(id);
+    return *this;
+  }
+  inline DenseIdSet<ID> operator|(const DenseIdSet<ID>& other) const {
+    DenseIdSet<ID> result = *this;
+    result |= other;
+    return result;
+  }
+  inline DenseIdSet<ID> operator&(const DenseIdSet<ID>& other) const {
+    DenseIdSet<ID> result = *this;
+    result &= other;
+    return result;
+  }
+  inline DenseIdSet<ID> operator-(const DenseIdSet<ID>& other) const {
+    DenseIdSet<ID> result = *this;
+    result -= other;
+    return result;
+  }
+
+  /**
+   * @brief The sets are equal when they have the same ids, the id range is
+   * not compared.
+   */
+  friend bool operator==(const DenseIdSet<ID>& lhs, const DenseIdSet<ID>& rhs) {
+    return lhs._size == rhs._size && lhs.isSubset(rhs);
+  }
+  friend bool operator!=(const DenseIdSet<ID>& lhs, const DenseIdSet<ID>& rhs) {
+    return !(lhs == rhs);
+  }
+
+  const std::vector<Word>& words() const { return _words; }
+
+ private:
+  std::vector<Word> _words;
+  size_t _size = 0;
+};
+
+/**
+ * @brief The map of the dense non negative integer ids to the values, the
+ * keys are the DenseIdSet and the values are stored in the array indexed by
+ * the id, so the lookup is one bit test and one array access.
+ *
+ * @tparam VALUE
+ * @tparam ID The integral id type.
+ */
+template <class VALUE, class ID = int>
+class DenseIdMap {
+ public:
+  // The value is referenced by address, which std::vector<bool> can not give.
+  static_assert(!std::is_same<VALUE, bool>::value,
+                "use DenseIdSet or DenseIdMap<char> for the bool value");
+  using key_type = ID;
+  using mapped_type = VALUE;
+  using size_type = size_t;
+
+  /**
+   * @brief The iterator of the (id, value) in ascending id order.
+   */
+  template <bool CONST>
+  class IteratorBase {
+   public:
+    using Values = typename std::conditional<CONST, const std::vector<VALUE>,
+                                             std::vector<VALUE>>::type;
+    using Ref = typename std::conditional<CONST, const VALUE&, VALUE&>::type;
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::pair<ID, Ref>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = value_type;
+
+    IteratorBase() = default;
+    IteratorBase(typename DenseIdSet<ID>::const_iterator iter, Values* values)
+        : _iter(iter), _values(values) {}
+
+    value_type operator*() const {
+      ID id = *_iter;
+      return value_type(id, (*_values)[static_cast<size_t>(id)]);
+    }
+    IteratorBase& operator++() {
+      ++_iter;
+      return *this;
+    }
+    IteratorBase operator++(int) {
+      IteratorBase tmp = *this;
+      ++_iter;
+      return tmp;
+    }
+    bool operator==(const IteratorBase& o) const { return _iter == o._iter; }
+    bool operator!=(const IteratorBase& o) const { return _iter != o._iter; }
+
+   private:
+    typename DenseIdSet<ID>::const_iterator _iter;
+    Values* _values = nullptr;
+  };
+  using iterator = IteratorBase<false>;
+  using const_iterator = IteratorBase<true>;
+
+  DenseIdMap() = default;
+  explicit DenseIdMap(size_t max_id) { reserve(max_id); }
+  ~DenseIdMap() = default;
+
+  iterator begin() { return iterator(_keys.begin(), &_values); }
+  iterator end() { return iterator(_keys.end(), &_values); }
+  const_iterator begin() const {
+    return const_iterator(_keys.begin(), &_values);
+  }
+  const_iterator end() const { return const_iterator(_keys.end(), &_values); }
+
+  size_t size() const { return _keys.size(); }
+  bool empty() const { return _keys.empty(); }
+  void reserve(size_t max_id) {
+    _keys.reserve(max_id);
+    if (_values.size() < max_id) {
+      _values.resize(max_id);
+    }
+  }
+  void clear() {
+    _keys.clear();
+    _values.clear();
+  }
+
+  /**
+   * @brief The id set of the map.
+   */
+  const DenseIdSet<ID>& keys() const { return _keys; }
+
+  bool contains(ID id) const { return _keys.contains(id); }
+  bool hasKey(ID id) const { return _keys.contains(id); }
+
+  /**
+   * @brief Find the value of the id.
+   *
+   * @return VALUE* The value, nullptr if not found.
+   */
+  VALUE* find(ID id) {
+    return contains(id) ? &_values[static_cast<size_t>(id)] : nullptr;
+  }
+  const VALUE* find(ID id) const {
+    return contains(id) ? &_values[static_cast<size_t>(id)] : nullptr;
+  }
+
+  const VALUE value(ID id, const VALUE& default_value = VALUE()) const {
+    const VALUE* found = find(id);
+    return found ? *found : default_value;
+  }
+
+  /**
+   * @brief Insert the (id, value), or assign the value if the id is existed.
+   */
+  template <class V>
+  void insert(ID id, V&& value) {
+    (*this)[id] = std::forward<V>(value);
+  }
+
+  /**
+   * @brief Get the value of the id, the default value is inserted if the id
+   * is not existed.The id should be non negative.
+   */
+  VALUE& operator[](ID id) {
+    assert(detail::isValidId(id));
+    size_t index = static_cast<size_t>(id);
+    if (index >= _values.size()) {
+      reserve(std::max(index + 1, _values.size() * 2));
+    }
+    _keys.insert(id);
+    return _values[index];
+  }
+
+  /**
+   * @brief Erase the id, the value is reset to the default value.
+   *
+   * @return size_t The erased number, zero or one.
+   */
+  size_t erase(ID id) {
+    if (_keys.erase(id) == 0) {
+      return 0;
+    }
+    _values[static_cast<size_t>(id)] = VALUE();
+    return 1;
+  }
+
+  /**
+   * @brief Call func(ID, VALUE&) on each element in ascending id order.
+   */
+  template <typename FUNC>
+  void forEach(FUNC&& func) {
+    _keys.forEach([this, &func](ID id) { func(id, _values[id]); });
+  }
+  template <typename FUNC>
+  void forEach(FUNC&& func) const {
+    _keys.forEach([this, &func](ID id) {
+      func(id, static_cast<const VALUE&>(_values[id]));
+    });
+  }
+
+ private:
+  DenseIdSet<ID> _keys;
+  std::vector<VALUE> _values;
+};
+
+}  // namespace pcl
@@ -0,0 +1,320 @@
+/**
+ * @file FlatMap.h
+ * @author simin tao (taosm@pcl.ac.cn)
+ * @brief The sorted flat map container for the eda project.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <list>
+#include <type_traits>
+#include <utility>
+
+#include "FlatSet.h"
+#include "RangeView.h"
+#include "Vector.h"
+
+namespace pcl {
+
+/**
+ * @brief A sorted map of unique keys stored in the contiguous Vector of
+ * (key, value) pairs.
+ *
+ * Like the FlatSet, the flat map suits the table built once and then looked
+ * up or range queried, such as the lib cell table, it is about half the
+ * memory of the btree Map and the lookup is the branchless binary search.The
+ * API follows the Map, so the Map can be replaced without other change.
+ *
+ * FlatMap<std::string, LibCell*> cells(all_cells.begin(), all_cells.end());
+ * for (auto iter = cells.lower_bound("AND"); iter != cells.end(); ++iter) {
+ *   ...
+ * }
+ *
+ * @tparam KEY
+ * @tparam VALUE
+ * @tparam CMP
+ */
+template <class KEY, class VALUE, class CMP = std::less<KEY>>
+class FlatMap {
+ public:
+  using key_type = KEY;
+  using mapped_type = VALUE;
+  using value_type = std::pair<KEY, VALUE>;
+  using key_compare = CMP;
+  using size_type = size_t;
+  using Storage = Vector<value_type>;
+  // The key of the item must not be modified through the iterator.
+  using iterator = typename Storage::iterator;
+  using const_iterator = typename Storage::const_iterator;
+  using reverse_iterator = typename Storage::reverse_iterator;
+  using const_reverse_iterator = typename Storage::const_reverse_iterator;
+  template <class K>
+  using key_arg = typename absl::container_internal::KeyArg<
+      absl::container_internal::IsTransparent<CMP>::value>::template type<K,
+                                                                           KEY>;
+
+  FlatMap() = default;
+  explicit FlatMap(const CMP& comp) : _comp(comp) {}
+  /**
+   * @brief Bulk load the items [first, last), which are sorted once, the
+   * first item of the equal keys is kept as the Map.
+   */
+  template <class ITER>
+  FlatMap(ITER first, ITER last, const CMP& comp = CMP()) : _comp(comp) {
+    insert(first, last);
+  }
+  FlatMap(std::initializer_list<value_type> items, const CMP& comp = CMP())
+      : FlatMap(items.begin(), items.end(), comp) {}
+  ~FlatMap() = default;
+
+  FlatMap(const FlatMap&) = default;
+  FlatMap(FlatMap&&) = default;
+  FlatMap& operator=(const FlatMap&) = default;
+  FlatMap& operator=(FlatMap&&) = default;
+
+  /*iterators*/
+  iterator begin() { return _items.begin(); }
+  iterator end() { return _items.end(); }
+  const_iterator begin() const { return _items.begin(); }
+  const_iterator end() const { return _items.end(); }
+  const_iterator cbegin() const { return _items.begin(); }
+  const_iterator cend() const { return _items.end(); }
+  reverse_iterator rbegin() { return _items.rbegin(); }
+  reverse_iterator rend() { return _items.rend(); }
+  const_reverse_iterator rbegin() const { return _items.rbegin(); }
+  const_reverse_iterator rend() const { return _items.rend(); }
+
+  /*capacity*/
+  bool empty() const { return _items.empty(); }
+  size_t size() const { return _items.size(); }
+  size_t capacity() const { return _items.capacity(); }
+  void reserve(size_t n) { _items.reserve(n); }
+  void shrink_to_fit() { _items.shrink_to_fit(); }
+
+  /*observer*/
+  key_compare key_comp() const { return _comp; }
+
+  /*modifiers*/
+  void clear() { _items.clear(); }
+  void swap(FlatMap& other) {
+    _items.swap(other._items);
+    std::swap(_comp, other._comp);
+  }
+
+  /**
+   * @brief Insert the (key, value) to the map, or assign the value if the key
+   * is existed, the items after it are moved.
+   */
+  template <class K = KEY, class V = VALUE,
+            typename std::enable_if<
+                std::is_constructible<KEY, K&&>::value &&
+                    std::is_constructible<VALUE, V&&>::value,
+                int>::type = 0>
+  void insert(K&& key, V&& value) {
+    auto iter = lowerBound(key);
+    if (iter != _items.end() && !_comp(key, iter->first)) {
+      iter->second = std::forward<V>(value);
+      return;
+    }
+    _items.emplace(iter, std::forward<K>(key), std::forward<V>(value));
+  }
+
+  /**
+   * @brief Bulk insert the items [first, last), the new items are appended,
+   * sorted and merged with the existed ones, the existed key is kept.
+   */
+  template <class ITER, class = typename std::iterator_traits<
+                            ITER>::iterator_category>
+  void insert(ITER first, ITER last) {
+    size_t old_size = _items.size();
+    _items.insert(_items.end(), first, last);
+    auto mid = _items.begin() + old_size;
+    auto less = [this](const value_type& a, const value_type& b) {
+      return _comp(a.first, b.first);
+    };
+    std::stable_sort(mid, _items.end(), less);
+    std::inplace_merge(_items.begin(), mid, _items.end(), less);
+    auto unique_end = std::unique(
+        _items.begin(), _items.end(),
+        [&less](const value_type& a, const value_type& b) {
+          return !less(a, b) && !less(b, a);
+        });
+    _items.erase(unique_end, _items.end());
+  }
+
+  /**
+   * @brief Get the value of the key, the default value is inserted if the
+   * key is not existed.
+   */
+  VALUE& operator[](const KEY& key) {
+    auto iter = lowerBound(key);
+    if (iter == _items.end() || _comp(key, iter->first)) {
+      iter = _items.emplace(iter, key, VALUE());
+    }
+    return iter->second;
+  }
+
+  template <class K = KEY>
+  size_t erase(const key_arg<K>& key) {
+    auto iter = find<K>(key);
+    if (iter == end()) {
+      return 0;
+    }
+    _items.erase(iter);
+    return 1;
+  }
+  iterator erase(const_iterator pos) { return _items.erase(pos); }
+  iterator erase(const_iterator first, const_iterator last) {
+    return _items.erase(first, last);
+  }
+
+  /*lookup*/
+  template <class K = KEY>
+  iterator lower_bound(const key_arg<K>& key) {
+    return lowerBound(key);
+  }
+  template <class K = KEY>
+  const_iterator lower_bound(const key_arg<K>& key) const {
+    return const_cast<FlatMap*>(this)->lowerBound(key);
+  }
+  template <class K = KEY>
+  iterator upper_bound(const key_arg<K>& key) {
+    return detail::flatLowerBound(
+        _items.begin(), _items.size(),
+        [this, &key](const value_type& e) { return !_comp(key, e.first); });
+  }
+  template <class K = KEY>
+  const_iterator upper_bound(const key_arg<K>& key) const {
+    return const_cast<FlatMap*>(this)->template upper_bound<K>(key);
+  }
+  template <class K = KEY>
+  iterator find(const key_arg<K>& key) {
+    auto iter = lowerBound(key);
+    return iter != _items.end() && !_comp(key, iter->first) ? iter
+                                                             : _items.end();
+  }
+  template <class K = KEY>
+  const_iterator find(const key_arg<K>& key) const {
+    return const_cast<FlatMap*>(this)->template find<K>(key);
+  }
+  template <class K = KEY>
+  std::pair<const_iterator, const_iterator> equal_range(
+      const key_arg<K>& key) const {
+    auto iter = find<K>(key);
+    return {iter, iter == end() ? iter : std::next(iter)};
+  }
+  template <class K = KEY>
+  bool contains(const key_arg<K>& key) const {
+    return find<K>(key) != end();
+  }
+  template <class K = KEY>
+  size_t count(const key_arg<K>& key) const {
+    return contains<K>(key) ? 1 : 0;
+  }
+
+  /**
+   * @brief Judge whether the key is in the map.
+   *
+   * @param key The key to be found.
+   * @return true if find out.
+   * @return false
+   */
+  template <class K = KEY>
+  bool hasKey(const key_arg<K>& key) const {
+    return contains<K>(key);
+  }
+
+  /**
+   * @brief Find the value corresponding to key.
+   *
+   * @param key The key to be found.
+   * @param default_value the default return value if not found.
+   * @return const VALUE return the found value.
+   */
+  template <class K = KEY>
+  const VALUE value(const key_arg<K>& key,
+                    const VALUE& default_value = VALUE()) const {
+    auto iter = find<K>(key);
+    return iter != end() ? iter->second : default_value;
+  }
+
+  /**
+   * @brief Get all keys in order.
+   *
+   * @return std::list<KEY> all map keys.
+   */
+  std::list<KEY> keys() const {
+    std::list<KEY> ret_value;
+    for (const auto& p : _items) {
+      ret_value.push_back(p.first);
+    }
+    return ret_value;
+  }
+
+  /**
+   * @brief Get all values in the key order.
+   *
+   * @return std::list<VALUE> all map values.
+   */
+  std::list<VALUE> values() const {
+    std::list<VALUE> ret_value;
+    for (const auto& p : _items) {
+      ret_value.push_back(p.second);
+    }
+    return ret_value;
+  }
+
+  /**
+   * @brief Get the lazy view of all keys, nothing is copied or allocated.
+   */
+  IteratorRange<KeyIterator<const_iterator>> keysView() const {
+    return makeKeysView(*this);
+  }
+
+  /**
+   * @brief Get the lazy view of all values.
+   */
+  IteratorRange<ValueIterator<iterator>> valuesView() {
+    return makeValuesView(*this);
+  }
+  IteratorRange<ValueIterator<const_iterator>> valuesView() const {
+    return makeValuesView(*this);
+  }
+
+  friend bool operator==(const FlatMap& lhs, const FlatMap& rhs) {
+    return lhs._items.size() == rhs._items.size() &&
+           std::equal(lhs._items.begin(), lhs._items.end(),
+                      rhs._items.begin());
+  }
+  friend bool operator!=(const FlatMap& lhs, const FlatMap& rhs) {
+    return !(lhs == rhs);
+  }
+
+ private:
+  template <class K>
+  iterator lowerBound(const K& key) {
+    return detail::flatLowerBound(
+        _items.begin(), _items.size(),
+        [this, &key](const value_type& e) { return _comp(e.first, key); });
+  }
+
+  Storage _items;
+  CMP _comp;
+};
+
+template <typename KEY, typename VALUE, typename CMP>
+void swap(FlatMap<KEY, VALUE, CMP>& x, FlatMap<KEY, VALUE, CMP>& y) {
+  x.swap(y);
+}
+
+}  // namespace pcl
@@ -0,0 +1,322 @@
+/**
+ * @file FlatSet.h
+ * @author simin tao (taosm@pcl.ac.cn)
+ * @brief The sorted flat set container for the eda project.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <utility>
+
+#include "Vector.h"
+#include "absl/container/internal/common.h"
+
+namespace pcl {
+
+namespace detail {
+
+/**
+ * @brief The first position in the sorted [first, first + n) where before is
+ * false, before must be true for a prefix of the range.
+ *
+ * The search halves the range without the data dependent branch, the
+ * compiler turns the select into the conditional move, so the mispredicted
+ * branches of std::lower_bound are avoided.The next two probe positions are
+ * prefetched for the large range.
+ */
+template <class ITER, class BEFORE>
+ITER flatLowerBound(ITER first, size_t n, BEFORE&& before) {
+  if (n == 0) {
+    return first;
+  }
+  while (n > 1) {
+    size_t half = n / 2;
+    __builtin_prefetch(&*(first + half / 2));
+    __builtin_prefetch(&*(first + half + half / 2));
+    first = before(first[half]) ? first + half : first;
+    n -= half;
+  }
+  return first + (before(*first) ? 1 : 0);
+}
+
+}  // namespace detail
+
+/**
+ * @brief A sorted set of unique keys stored in the contiguous Vector.
+ *
+ * Compared with the btree Set, the flat set has no node overhead and the
+ * search is the branchless binary search on one array, so it is faster and
+ * smaller for the set built once and then queried, while the insert or erase
+ * in the middle moves the elements after it.Build the set by the range
+ * constructor or insert(first, last), which sorts once.
+ *
+ * @tparam KEY
+ * @tparam CMP
+ */
+template <class KEY, class CMP = std::less<KEY>>
+class FlatSet {
+ public:
+  using key_type = KEY;
+  using value_type = KEY;
+  using key_compare = CMP;
+  using value_compare = CMP;
+  using size_type = size_t;
+  using Storage = Vector<KEY>;
+  // The keys are sorted, so they are not modified through the iterator.
+  using iterator = typename Storage::const_iterator;
+  using const_iterator = typename Storage::const_iterator;
+  using reverse_iterator = typename Storage::const_reverse_iterator;
+  using const_reverse_iterator = typename Storage::const_reverse_iterator;
+  // The key type of heterogeneous lookup, it is K when the comparator is
+  // transparent, otherwise KEY.
+  template <class K>
+  using key_arg = typename absl::container_internal::KeyArg<
+      absl::container_internal::IsTransparent<CMP>::value>::template type<K,
+                                                                           KEY>;
+
+  FlatSet() = default;
+  explicit FlatSet(const CMP& comp) : _comp(comp) {}
+  template <class ITER>
+  FlatSet(ITER first, ITER last, const CMP& comp = CMP()) : _comp(comp) {
+    insert(first, last);
+  }
+  FlatSet(std::initializer_list<KEY> keys, const CMP& comp = CMP())
+      : FlatSet(keys.begin(), keys.end(), comp) {}
+  ~FlatSet() = default;
+
+  FlatSet(const FlatSet&) = default;
+  FlatSet(FlatSet&&) = default;
+  FlatSet& operator=(const FlatSet&) = default;
+  FlatSet& operator=(FlatSet&&) = default;
+
+  /*iterators*/
+  const_iterator begin() const { return _keys.begin(); }
+  const_iterator end() const { return _keys.end(); }
+  const_iterator cbegin() const { return _keys.begin(); }
+  const_iterator cend() const { return _keys.end(); }
+  const_reverse_iterator rbegin() const { return _keys.rbegin(); }
+  const_reverse_iterator rend() const { return _keys.rend(); }
+
+  /*capacity*/
+  bool empty() const { return _keys.empty(); }
+  size_t size() const { return _keys.size(); }
+  size_t capacity() const { return _keys.capacity(); }
+  void reserve(size_t n) { _keys.reserve(n); }
+  void shrink_to_fit() { _keys.shrink_to_fit(); }
+
+  /*observer*/
+  key_compare key_comp() const { return _comp; }
+  value_compare value_comp() const { return _comp; }
+
+  /**
+   * @brief The sorted keys.
+   */
+  const Storage& data() const { return _keys; }
+
+  /*modifiers*/
+  void clear() { _keys.clear(); }
+  void swap(FlatSet& other) {
+    _keys.swap(other._keys);
+    std::swap(_comp, other._comp);
+  }
+
+  /**
+   * @brief Insert the key, the keys after it are moved.
+   *
+   * @return std::pair<const_iterator, bool> The key position, and whether
+   * it is inserted.
+   */
+  std::pair<const_iterator, bool> insert(const KEY& key) {
+    auto iter = lower_bound(key);
+    if (iter != end() && !_comp(key, *iter)) {
+      return {iter, false};
+    }
+    size_t pos = iter - begin();
+    _keys.insert(_keys.begin() + pos, key);
+    return {begin() + pos, true};
+  }
+
+  /**
+   * @brief Bulk insert the keys [first, last), the new keys are appended,
+   * sorted and merged with the existed ones, O((n + m) log m).
+   */
+  template <class ITER>
+  void insert(ITER first, ITER last) {
+    size_t old_size = _keys.size();
+    _keys.insert(_keys.end(), first, last);
+    auto mid = _keys.begin() + old_size;
+    std::stable_sort(mid, _keys.end(), _comp);
+    std::inplace_merge(_keys.begin(), mid, _keys.end(), _comp);
+    unique();
+  }
+  void insert(std::initializer_list<KEY> keys) {
+    insert(keys.begin(), keys.end());
+  }
+
+  /**
+   * @brief Erase the key.
+   *
+   * @return size_t The erased number, zero or one.
+   */
+  template <class K = KEY>
+  size_t erase(const key_arg<K>& key) {
+    auto iter = find(key);
+    if (iter == end()) {
+      return 0;
+    }
+    erase(iter);
+    return 1;
+  }
+  const_iterator erase(const_iterator pos) {
+    size_t index = pos - begin();
+    _keys.erase(_keys.begin() + index);
+    return begin() + index;
+  }
+  const_iterator erase(const_iterator first, const_iterator last) {
+    size_t index = first - begin();
+    _keys.erase(_keys.begin() + index, _keys.begin() + (last - begin()));
+    return begin() + index;
+  }
+
+  /*lookup*/
+  template <class K = KEY>
+  const_iterator lower_bound(const key_arg<K>& key) const {
+    return detail::flatLowerBound(
+        begin(), size(), [this, &key](const KEY& e) { return _comp(e, key); });
+  }
+  template <class K = KEY>
+  const_iterator upper_bound(const key_arg<K>& key) const {
+    return detail::flatLowerBound(
+        begin(), size(), [this, &key](const KEY& e) { return !_comp(key, e); });
+  }
+  template <class K = KEY>
+  std::pair<const_iterator, const_iterator> equal_range(
+      const key_arg<K>& key) const {
+    auto iter = find(key);
+    return {iter, iter == end() ? iter : std::next(iter)};
+  }
+  template <class K = KEY>
+  const_iterator find(const key_arg<K>& key) const {
+    auto iter = lower_bound<K>(key);
+    return iter != end() && !_comp(key, *iter) ? iter : end();
+  }
+  template <class K = KEY>
+  bool contains(const key_arg<K>& key) const {
+    return find<K>(key) != end();
+  }
+  template <class K = KEY>
+  size_t count(const key_arg<K>& key) const {
+    return contains<K>(key) ? 1 : 0;
+  }
+  template <class K = KEY>
+  bool hasKey(const key_arg<K>& key) const {
+    return contains<K>(key);
+  }
+
+  /**
+   * @brief Removes all items from this set that are contained in the other set.
+   *
+   * @param other
+   * @return FlatSet<KEY, CMP>& This set after subtract the other.
+   */
+  FlatSet<KEY, CMP>& subtract(const FlatSet<KEY, CMP>& other) {
+    auto last = std::remove_if(_keys.begin(), _keys.end(),
+                               [&other](const KEY& key) {
+                                 return other.contains(key);
+                               });
+    _keys.erase(last, _keys.end());
+    return *this;
+  }
+
+  /**
+   * @brief Insert all items from the other set with one linear merge.
+   *
+   * @param other
+   * @return FlatSet<KEY, CMP>& This set after unite the other.
+   */
+  FlatSet<KEY, CMP>& unite(const FlatSet<KEY, CMP>& other) {
+    Storage result;
+    result.reserve(size() + other.size());
+    std::set_union(begin(), end(), other.begin(), other.end(),
+                   std::back_inserter(result), _comp);
+    _keys.swap(result);
+    return *this;
+  }
+
+  /**
+   * @brief Calculate the intersect between this and other.
+   *
+   * @param other
+   * @return FlatSet<KEY, CMP>& This set after intersect the other.
+   */
+  FlatSet<KEY, CMP>& intersect(const FlatSet<KEY, CMP>& other) {
+    auto last = std::remove_if(_keys.begin(), _keys.end(),
+                               [&other](const KEY& key) {
+                                 return !other.contains(key);
+                               });
+    _keys.erase(last, _keys.end());
+    return *this;
+  }
+
+  inline FlatSet<KEY, CMP>& operator|=(const FlatSet<KEY, CMP>& other) {
+    return unite(other);
+  }
+  inline FlatSet<KEY, CMP>& operator&=(const FlatSet<KEY, CMP>& other) {
+    return intersect(other);
+  }
+  inline FlatSet<KEY, CMP>& operator-=(const FlatSet<KEY, CMP>& other) {
+    return subtract(other);
+  }
+  inline FlatSet<KEY, CMP> operator|(const FlatSet<KEY, CMP>& other) const {
+    FlatSet<KEY, CMP> result = *this;
+    return result.unite(other);
+  }
+  inline FlatSet<KEY, CMP> operator&(const FlatSet<KEY, CMP>& other) const {
+    FlatSet<KEY, CMP> result = *this;
+    return result.intersect(other);
+  }
+  inline FlatSet<KEY, CMP> operator-(const FlatSet<KEY, CMP>& other) const {
+    FlatSet<KEY, CMP> result = *this;
+    return result.subtract(other);
+  }
+
+  friend bool operator==(const FlatSet<KEY, CMP>& lhs,
+                         const FlatSet<KEY, CMP>& rhs) {
+    return lhs.size() == rhs.size() &&
+           std::equal(lhs.begin(), lhs.end(), rhs.begin());
+  }
+  friend bool operator!=(const FlatSet<KEY, CMP>& lhs,
+                         const FlatSet<KEY, CMP>& rhs) {
+    return !(lhs == rhs);
+  }
+
+ private:
+  // Keep the first of the equal keys, the keys are sorted.
+  void unique() {
+    auto last = std::unique(_keys.begin(), _keys.end(),
+                            [this](const KEY& a, const KEY& b) {
+                              return !_comp(a, b) && !_comp(b, a);
+                            });
+    _keys.erase(last, _keys.end());
+  }
+
+  Storage _keys;
+  CMP _comp;
+};
+
+template <typename KEY, typename CMP>
+void swap(FlatSet<KEY, CMP>& x, FlatSet<KEY, CMP>& y) {
+  x.swap(y);
+}
+
+}  // namespace pcl
@@ -0,0 +1,593 @@
+/**
+ * @file FrozenHashMap.h
+ * @author simin tao (taosm@pcl.ac.cn)
+ * @brief The immutable minimal perfect hash map for the eda project.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "absl/hash/internal/city.h"
+#include "absl/strings/string_view.h"
+
+namespace pcl {
+
+/**
+ * @brief The murmur3 finalizer, a bijection of 64 bit integer.
+ */
+inline uint64_t mixHash64(uint64_t h) {
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdull;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ull;
+  h ^= h >> 33;
+  return h;
+}
+
+/**
+ * @brief The hash of FrozenHashMap, it must be the same in every process
+ * because the map can be saved to disk, so the absl::Hash which is seeded per
+ * process can not be used.
+ *
+ * @tparam KEY The integral, enum or std::string key.
+ */
+template <class KEY, class = void>
+struct FrozenHash;
+
+template <class KEY>
+struct FrozenHash<KEY, typename std::enable_if<
+                           std::is_integral<KEY>::value ||
+                           std::is_enum<KEY>::value>::type> {
+  uint64_t operator()(KEY key) const {
+    return mixHash64(static_cast<uint64_t>(key));
+  }
+};
+
+template <>
+struct FrozenHash<std::string> {
+  uint64_t operator()(absl::string_view key) const {
+    return absl::hash_internal::CityHash64(key.data(), key.size());
+  }
+};
+
+/**
+ * @brief An immutable hash map built once from the HashMap by the minimal
+ * perfect hash.
+ *
+ * The keys are hashed into buckets of about four keys, and the buckets are
+ * placed from the largest one by searching a displacement which maps all keys
+ * of the bucket to free slots(CHD algorithm), the single key buckets take the
+ * remained slots directly.So the n keys occupy exactly n slots, the keys and
+ * values are stored in contiguous arrays without empty slot, and each lookup
+ * reads one displacement and compares one key.The displacement costs about
+ * one byte per key.
+ *
+ * All data live in one buffer with the same layout as the file, so the map
+ * can be saved to disk and loaded by mmap without any parsing.The key should
+ * be trivially copyable or std::string(stored as one character blob), and the
+ * value should be trivially copyable.The pointer value is only meaningful in
+ * the process which saves it.
+ *
+ * HashMap<std::string, int> hmap = {{"INV_X1", 1}, {"NAND2_X1", 2}};
+ * auto frozen = freeze(hmap);
+ * if (frozen) {
+ *   frozen->save("cells.fhm");
+ * }
+ * FrozenHashMap<std::string, int> loaded;
+ * loaded.load("cells.fhm");
+ * int id = loaded.value("INV_X1");
+ *
+ * @tparam KEY Type of key.
+ * @tparam VALUE Type of value.
+ * @tparam HASH The stable hash returning uint64_t.
+ */
+template <class KEY, class VALUE, class HASH = FrozenHash<KEY>>
+class FrozenHashMap {
+ public:
+  static constexpr bool kStringKey = std::is_same<KEY, std::string>::value;
+  static_assert(kStringKey || std::is_trivially_copyable<KEY>::value,
+                "the key should be trivially copyable or std::string.");
+  static_assert(std::is_trivially_copyable<VALUE>::value,
+                "the value should be trivially copyable.");
+
+  // The string key is looked up by string view without copy.
+  using key_arg = typename std::conditional<kStringKey, absl::string_view,
+                                            const KEY&>::type;
+
+  FrozenHashMap() = default;
+  ~FrozenHashMap() = default;
+
+  /**
+   * @brief Build the map from the container of (key, value) pairs, the old
+   * content is replaced.
+   *
+   * @param map The source container such as pcl::HashMap.
+   * @return true if built.
+   * @return false if two keys have the same 64 bit hash or no seed places
+   * the keys, the map is empty.
+   */
+  template <class MAP>
+  bool build(const MAP& map) {
+    std::vector<const typename MAP::value_type*> items;
+    std::vector<uint64_t> hashes;
+    items.reserve(map.size());
+    hashes.reserve(map.size());
+    for (const auto& item : map) {
+      items.push_back(&item);
+      hashes.push_back(_hash(item.first));
+    }
+
+    // The keys of the same hash can never be placed by any seed, so it fails
+    // before the search.
+    std::vector<uint64_t> sorted_hashes = hashes;
+    std::sort(sorted_hashes.begin(), sorted_hashes.end());
+    if (std::adjacent_find(sorted_hashes.begin(), sorted_hashes.end()) !=
+        sorted_hashes.end()) {
+      *this = FrozenHashMap();
+      return false;
+    }
+
+    size_t num_keys = items.size();
+    size_t num_buckets = num_keys / kKeysPerBucket + 1;
+    std::vector<uint32_t> disp;
+    std::vector<uint32_t> slots;
+    uint64_t seed = 0;
+    while (!place(hashes, seed, num_buckets, &disp, &slots)) {
+      if (++seed == kMaxSeeds) {
+        *this = FrozenHashMap();
+        return false;
+      }
+    }
+
+    Header header;
+    std::memcpy(header.magic, kMagic, sizeof(header.magic));
+    header.version = kVersion;
+    header.key_kind = kStringKey ? 1 : 0;
+    header.num_keys = num_keys;
+    header.num_buckets = num_buckets;
+    header.seed = seed;
+    header.key_size = kStringKey ? 0 : sizeof(KEY);
+    header.value_size = sizeof(VALUE);
+    header.blob_size = 0;
+    if constexpr (kStringKey) {
+      for (const auto* item : items) {
+        header.blob_size += item->first.size();
+      }
+    }
+
+    Layout layout = computeLayout(header);
+    std::shared_ptr<const char> owner = allocBuffer(layout.total);
+    char* buffer = const_cast<char*>(owner.get());
+    std::memset(buffer, 0, layout.total);
+    std::memcpy(buffer, &header, sizeof(header));
+    std::memcpy(buffer + layout.disp, disp.data(),
+                num_buckets * sizeof(uint32_t));
+
+    VALUE* values = reinterpret_cast<VALUE*>(buffer + layout.values);
+    if constexpr (kStringKey) {
+      // The offsets are the prefix sum of the key length in slot order.
+      uint64_t* offsets = reinterpret_cast<uint64_t*>(buffer + layout.keys);
+      for (size_t i = 0; i < num_keys; ++i) {
+        offsets[slots[i] + 1] = items[i]->first.size();
+      }
+      for (size_t slot = 0; slot < num_keys; ++slot) {
+        offsets[slot + 1] += offsets[slot];
+      }
+      char* blob = buffer + layout.blob;
+      for (size_t i = 0; i < num_keys; ++i) {
+        std::memcpy(blob + offsets[slots[i]], items[i]->first.data(),
+                    items[i]->first.size());
+      }
+    } else {
+      KEY* keys = reinterpret_cast<KEY*>(buffer + layout.keys);
+      for (size_t i = 0; i < num_keys; ++i) {
+        keys[slots[i]] = items[i]->first;
+      }
+    }
+    for (size_t i = 0; i < num_keys; ++i) {
+      values[slots[i]] = items[i]->second;
+    }
+
+    _buffer = std::move(owner);
+    _buffer_size = layout.total;
+    bind();
+    return true;
+  }
+
+  size_t size() const { return _num_keys; }
+  bool empty() const { return _num_keys == 0; }
+
+  /**
+   * @brief The bytes of the whole map, the same as the file size.
+   */
+  size_t memoryBytes() const { return _buffer_size; }
+
+  /**
+   * @brief Find the value of the key.
+   *
+   * @param key
+   * @return const VALUE* The found value, nullptr if not found.
+   */
+  const VALUE* find(key_arg key) const {
+    if (_num_keys == 0) {
+      return nullptr;
+    }
+    size_t slot = slotOf(_hash(key));
+    return keyEqual(slot, key) ? _values + slot : nullptr;
+  }
+
+  /**
+   * @brief Find out if key is in the map.
+   *
+   * @param key
+   * @return true if find out.
+   * @return false
+   */
+  bool hasKey(key_arg key) const { return find(key) != nullptr; }
+
+  /**
+   * @brief Find the value corresponding to the key.
+   *
+   * @param key
+   * @param default_value The default return value if not found.
+   * @return const VALUE Return the found value.
+   */
+  const VALUE value(key_arg key, const VALUE& default_value = VALUE()) const {
+    const VALUE* found = find(key);
+    return found ? *found : default_value;
+  }
+
+  /**
+   * @brief Call func(key, value) on each element in slot order, the string
+   * key is passed as string view.
+   */
+  template <typename FUNC>
+  void forEach(FUNC&& func) const {
+    for (size_t slot = 0; slot < _num_keys; ++slot) {
+      func(keyAt(slot), _values[slot]);
+    }
+  }
+
+  /**
+   * @brief Write the map to the file.
+   *
+   * @param file_name
+   * @return true if written.
+   * @return false
+   */
+  bool save(const char* file_name) const {
+    if (!_buffer) {
+      return false;
+    }
+    FILE* fp = std::fopen(file_name, "wb");
+    if (fp == nullptr) {
+      return false;
+    }
+    bool ok = std::fwrite(_buffer.get(), 1, _buffer_size, fp) == _buffer_size;
+    return std::fclose(fp) == 0 && ok;
+  }
+
+  /**
+   * @brief Load the map saved by save(), the file is mapped to memory and
+   * kept mapped until the map and its copies are destroyed.
+   *
+   * @param file_name
+   * @return true if loaded.
+   * @return false if the file can not be read or is not the map of the same
+   * key and value type, the map is unchanged.
+   */
+  bool load(const char* file_name) {
+    std::shared_ptr<const char> buffer;
+    size_t buffer_size = 0;
+#if defined(__unix__) || defined(__APPLE__)
+    int fd = ::open(file_name, O_RDONLY);
+    if (fd < 0) {
+      return false;
+    }
+    struct stat file_stat;
+    if (::fstat(fd, &file_stat) != 0 || file_stat.st_size == 0) {
+      ::close(fd);
+      return false;
+    }
+    buffer_size = file_stat.st_size;
+    void* addr = ::mmap(nullptr, buffer_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED) {
+      return false;
+    }
+    buffer.reset(static_cast<const char*>(addr),
+                 [buffer_size](const char* p) {
+                   ::munmap(const_cast<char*>(p), buffer_size);
+                 });
+#else
+    FILE* fp = std::fopen(file_name, "rb");
+    if (fp == nullptr) {
+      return false;
+    }
+    std::fseek(fp, 0, SEEK_END);
+    buffer_size = std::ftell(fp);
+    std::fseek(fp, 0, SEEK_SET);
+    buffer = allocBuffer(buffer_size);
+    bool ok = std::fread(const_cast<char*>(buffer.get()), 1, buffer_size, fp) ==
+              buffer_size;
+    std::fclose(fp);
+    if (!ok) {
+      return false;
+    }
+#endif
+
+    if (!checkBuffer(buffer.get(), buffer_size)) {
+      return false;
+    }
+    _buffer = std::move(buffer);
+    _buffer_size = buffer_size;
+    bind();
+    return true;
+  }
+
+ private:
+  static constexpr size_t kKeysPerBucket = 4;
+  static constexpr uint64_t kMaxSeeds = 16;
+  static constexpr uint32_t kMaxDisplacement = 1u << 24;
+  // The displacement of the single key bucket is the slot with the flag.
+  static constexpr uint32_t kDirectFlag = 1u << 31;
+  static constexpr size_t kAlign = 64;
+  static constexpr uint32_t kVersion = 1;
+  static constexpr char kMagic[8] = {'P', 'C', 'L', 'F', 'H', 'M', 'A', 'P'};
+
+  struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t key_kind;
+    uint64_t num_keys;
+    uint64_t num_buckets;
+    uint64_t seed;
+    uint64_t key_size;
+    uint64_t value_size;
+    uint64_t blob_size;
+  };
+
+  // The byte offset of each section in the buffer.
+  struct Layout {
+    size_t disp;
+    size_t keys;
+    size_t blob;
+    size_t values;
+    size_t total;
+  };
+
+  static size_t alignUp(size_t n) { return (n + kAlign - 1) / kAlign * kAlign; }
+
+  static std::shared_ptr<const char> allocBuffer(size_t size) {
+    struct alignas(kAlign) Block {
+      char data[kAlign];
+    };
+    Block* blocks = new Block[alignUp(size) / kAlign];
+    return std::shared_ptr<const char>(
+        reinterpret_cast<const char*>(blocks),
+        [blocks](const char*) { delete[] blocks; });
+  }
+
+  static Layout computeLayout(const Header& header) {
+    Layout layout;
+    layout.disp = alignUp(sizeof(Header));
+    layout.keys = alignUp(layout.disp + header.num_buckets * sizeof(uint32_t));
+    size_t key_bytes = kStringKey ? (header.num_keys + 1) * sizeof(uint64_t)
+                                  : header.num_keys * sizeof(KEY);
+    layout.blob = alignUp(layout.keys + key_bytes);
+    layout.values = alignUp(layout.blob + header.blob_size);
+    layout.total = layout.values + header.num_keys * sizeof(VALUE);
+    return layout;
+  }
+
+  static bool checkBuffer(const char* buffer, size_t buffer_size) {
+    if (buffer_size < sizeof(Header)) {
+      return false;
+    }
+    Header header;
+    std::memcpy(&header, buffer, sizeof(header));
+    return std::memcmp(header.magic, kMagic, sizeof(header.magic)) == 0 &&
+           header.version == kVersion &&
+           header.key_kind == (kStringKey ? 1u : 0u) &&
+           header.key_size == (kStringKey ? 0 : sizeof(KEY)) &&
+           header.value_size == sizeof(VALUE) &&
+           header.num_keys < kDirectFlag &&
+           computeLayout(header).total == buffer_size;
+  }
+
+  static uint32_t bucketOf(uint64_t h, size_t num_buckets) {
+    return static_cast<uint32_t>(((h >> 32) * num_buckets) >> 32);
+  }
+
+  static uint32_t slotOf(uint64_t h, uint32_t disp, size_t num_keys) {
+    uint64_t x = mixHash64(h ^ (disp * 0x9e3779b97f4a7c15ull));
+    return static_cast<uint32_t>(((x & 0xffffffffull) * num_keys) >> 32);
+  }
+
+  /**
+   * @brief Search the displacement of each bucket.
+   *
+   * @param hashes The key hashes.
+   * @param seed The seed mixed into the hashes.
+   * @param num_buckets The bucket number.
+   * @param disp The displacement of each bucket.
+   * @param slots The slot of each key.
+   * @return true if all keys are placed.
+   * @return false
+   */
+  static bool place(const std::vector<uint64_t>& hashes, uint64_t seed,
+                    size_t num_buckets, std::vector<uint32_t>* disp,
+                    std::vector<uint32_t>* slots) {
+    size_t num_keys = hashes.size();
+    if (num_keys >= kDirectFlag) {
+      return false;
+    }
+    std::vector<uint64_t> mixed(num_keys);
+    std::vector<uint32_t> bucket_start(num_buckets + 1, 0);
+    for (size_t i = 0; i < num_keys; ++i) {
+      mixed[i] = mixHash64(hashes[i] ^ seed);
+      ++bucket_start[bucketOf(mixed[i], num_buckets) + 1];
+    }
+    uint32_t max_size = 0;
+    for (size_t b = 0; b < num_buckets; ++b) {
+      max_size = std::max(max_size, bucket_start[b + 1]);
+      bucket_start[b + 1] += bucket_start[b];
+    }
+    std::vector<uint32_t> bucket_keys(num_keys);
+    std::vector<uint32_t> fill(bucket_start.begin(), bucket_start.end() - 1);
+    for (size_t i = 0; i < num_keys; ++i) {
+      bucket_keys[fill[bucketOf(mixed[i], num_buckets)]++] = i;
+    }
+
+    // Sort the buckets by size in descending order.
+    std::vector<uint32_t> size_start(max_size + 2, 0);
+    for (size_t b = 0; b < num_buckets; ++b) {
+      ++size_start[max_size - (bucket_start[b + 1] - bucket_start[b]) + 1];
+    }
+    for (uint32_t s = 0; s <= max_size; ++s) {
+      size_start[s + 1] += size_start[s];
+    }
+    std::vector<uint32_t> order(num_buckets);
+    for (size_t b = 0; b < num_buckets; ++b) {
+      order[size_start[max_size - (bucket_start[b + 1] - bucket_start[b])]++] =
+          b;
+    }
+
+    disp->assign(num_buckets, 0);
+    slots->assign(num_keys, 0);
+    std::vector<char> taken(num_keys, 0);
+    std::vector<uint32_t> bucket_slots;
+    size_t next_free = 0;
+    for (uint32_t b : order) {
+      uint32_t first = bucket_start[b];
+      uint32_t last = bucket_start[b + 1];
+      if (last - first == 0) {
+        break;
+      } else if (last - first == 1) {
+        while (taken[next_free]) {
+          ++next_free;
+        }
+        taken[next_free] = 1;
+        (*disp)[b] = kDirectFlag | static_cast<uint32_t>(next_free);
+        (*slots)[bucket_keys[first]] = next_free;
+        continue;
+      }
+
+      uint32_t d = 0;
+      for (; d < kMaxDisplacement; ++d) {
+        bucket_slots.clear();
+        for (uint32_t i = first; i < last; ++i) {
+          uint32_t slot = slotOf(mixed[bucket_keys[i]], d, num_keys);
+          if (taken[slot] || std::find(bucket_slots.begin(), bucket_slots.end(),
+                                       slot) != bucket_slots.end()) {
+            break;
+          }
+          bucket_slots.push_back(slot);
+        }
+        if (bucket_slots.size() == last - first) {
+          break;
+        }
+      }
+      if (d == kMaxDisplacement) {
+        return false;
+      }
+      (*disp)[b] = d;
+      for (uint32_t i = first; i < last; ++i) {
+        taken[bucket_slots[i - first]] = 1;
+        (*slots)[bucket_keys[i]] = bucket_slots[i - first];
+      }
+    }
+    return true;
+  }
+
+  void bind() {
+    Header header;
+    std::memcpy(&header, _buffer.get(), sizeof(header));
+    Layout layout = computeLayout(header);
+    const char* buffer = _buffer.get();
+    _num_keys = header.num_keys;
+    _num_buckets = header.num_buckets;
+    _seed = header.seed;
+    _disp = reinterpret_cast<const uint32_t*>(buffer + layout.disp);
+    _keys = buffer + layout.keys;
+    _blob = buffer + layout.blob;
+    _values = reinterpret_cast<const VALUE*>(buffer + layout.values);
+  }
+
+  size_t slotOf(uint64_t hash) const {
+    uint64_t h = mixHash64(hash ^ _seed);
+    uint32_t d = _disp[bucketOf(h, _num_buckets)];
+    return (d & kDirectFlag) ? (d & ~kDirectFlag) : slotOf(h, d, _num_keys);
+  }
+
+  key_arg keyAt(size_t slot) const {
+    if constexpr (kStringKey) {
+      const uint64_t* offsets = reinterpret_cast<const uint64_t*>(_keys);
+      return absl::string_view(_blob + offsets[slot],
+                               offsets[slot + 1] - offsets[slot]);
+    } else {
+      return reinterpret_cast<const KEY*>(_keys)[slot];
+    }
+  }
+
+  bool keyEqual(size_t slot, key_arg key) const { return keyAt(slot) == key; }
+
+  HASH _hash;
+  std::shared_ptr<const char> _buffer;
+  size_t _buffer_size = 0;
+  size_t _num_keys = 0;
+  size_t _num_buckets = 0;
+  uint64_t _seed = 0;
+  const uint32_t* _disp = nullptr;
+  const char* _keys = nullptr;
+  const char* _blob = nullptr;
+  const VALUE* _values = nullptr;
+};
+
+/**
+ * @brief Build the immutable minimal perfect hash map of the elements for
+ * the table which is only queried after loading.
+ *
+ * @tparam MAP The source container such as pcl::HashMap.
+ * @tparam FROZEN_HASH The stable hash of the key.
+ * @param map
+ * @return The frozen map, or std::nullopt if two keys have the same 64 bit
+ * hash or no seed places the keys, so the failure is not mistaken for an
+ * empty map.
+ */
+template <class MAP,
+          class FROZEN_HASH = FrozenHash<typename MAP::key_type>>
+std::optional<FrozenHashMap<typename MAP::key_type, typename MAP::mapped_type,
+                            FROZEN_HASH>>
+freeze(const MAP& map) {
+  FrozenHashMap<typename MAP::key_type, typename MAP::mapped_type, FROZEN_HASH>
+      frozen;
+  if (!frozen.build(map)) {
+    return std::nullopt;
+  }
+  return frozen;
+}
+
+}  // namespace pcl
@@ -0,0 +1,55 @@
+/**
+ * @file HashBatch.h
+ * @author simin tao (taosm@pcl.ac.cn)
+ * @brief The batch lookup of the swiss table for the eda project.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+
+namespace pcl {
+
+/**
+ * @brief Look up many independent keys in the swiss table, the result of key i
+ * is passed to func(i, const_iterator).
+ *
+ * The keys are processed in tiles.For each tile the control bytes and slots
+ * of every key are prefetched first, then the lookups are resolved, so the
+ * cache misses of the tile are in flight at the same time instead of one
+ * after another.The table has no prefetch by hash, so each key is hashed by
+ * the prefetch and again by the find.
+ *
+ * @tparam TABLE The absl flat hash map or set.
+ * @tparam KEY Type of the lookup key.
+ * @tparam FUNC The callable type of void(size_t, const_iterator).
+ * @param table The hash table.
+ * @param keys The keys.
+ * @param num_keys The key number.
+ * @param func The result function.
+ */
+template <class TABLE, class KEY, class FUNC>
+void lookupBatch(const TABLE& table, const KEY* keys, size_t num_keys,
+                 FUNC&& func) {
+  // Each key prefetches two cache lines, the tile fits in the L1 cache with
+  // enough lookups in flight.
+  constexpr size_t kTileSize = 16;
+  for (size_t first = 0; first < num_keys; first += kTileSize) {
+    size_t num = std::min(kTileSize, num_keys - first);
+    const KEY* tile = keys + first;
+    for (size_t i = 0; i < num; ++i) {
+      table.prefetch(tile[i]);
+    }
+    for (size_t i = 0; i < num; ++i) {
+      func(first + i, table.find(tile[i]));
+    }
+  }
+}
+
+}  // namespace pcl
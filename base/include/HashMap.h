@@ -11,9 +11,17 @@
 
 #pragma once
 
+#include <iterator>
 #include <list>
+#include <string>
+#include <type_traits>
 #include <unordered_map>
+#include <utility>
 
+#include "HashBatch.h"
+#include "HashTableStats.h"
+#include "RangeView.h"
+#include "Vector.h"
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/node_hash_map.h"
 
@@ -66,6 +74,10 @@ class HashMap : public absl::flat_hash_map<KEY, VALUE, HASH, EQ> {
   using value_type = typename Base::value_type;
   using hash = typename Base::hasher;
   using eq = typename Base::key_equal;
+  // The key type of heterogeneous lookup, it is K when the hash and eq are
+  // transparent, otherwise KEY.
+  template <class K>
+  using key_arg = typename Base::template key_arg<K>;
 
   /*constructor*/
   using Base::Base;
@@ -123,7 +135,7 @@ class HashMap : public absl::flat_hash_map<KEY, VALUE, HASH, EQ> {
    */
   std::list<KEY> keys() const {
     std::list<KEY> ret_value;
-    for (auto p : *this) {
+    for (const auto& p : *this) {
       ret_value.push_back(p.first);
     }
     return ret_value;
@@ -136,12 +148,58 @@ class HashMap : public absl::flat_hash_map<KEY, VALUE, HASH, EQ> {
    */
   std::list<VALUE> values() const {
     std::list<VALUE> ret_value;
-    for (auto p : *this) {
+    for (const auto& p : *this) {
       ret_value.push_back(p.second);
     }
     return ret_value;
   }
 
+  /**
+   * @brief Get the lazy view of all keys, nothing is copied or allocated.
+   *
+   * @return IteratorRange The keys range valid until the map is modified.
+   */
+  IteratorRange<KeyIterator<const_iterator>> keysView() const {
+    return makeKeysView(*this);
+  }
+
+  /**
+   * @brief Get the lazy view of all values, the value can be modified through
+   * the view of the non const map.
+   *
+   * @return IteratorRange The values range valid until the map is modified.
+   */
+  IteratorRange<ValueIterator<iterator>> valuesView() {
+    return makeValuesView(*this);
+  }
+  IteratorRange<ValueIterator<const_iterator>> valuesView() const {
+    return makeValuesView(*this);
+  }
+
+  /**
+   * @brief Append all keys to the vector with one reservation.
+   *
+   * @param keys The vector of keys.
+   */
+  void keysInto(Vector<KEY>* keys) const {
+    keys->reserve(keys->size() + this->size());
+    for (const auto& p : *this) {
+      keys->push_back(p.first);
+    }
+  }
+
+  /**
+   * @brief Append all values to the vector with one reservation.
+   *
+   * @param values The vector of values.
+   */
+  void valuesInto(Vector<VALUE>* values) const {
+    values->reserve(values->size() + this->size());
+    for (const auto& p : *this) {
+      values->push_back(p.second);
+    }
+  }
+
   /**
    * @brief Find out if key is in the map.
    *
@@ -149,7 +207,10 @@ class HashMap : public absl::flat_hash_map<KEY, VALUE, HASH, EQ> {
    * @return true if find out.
    * @return false
    */
-  bool hasKey(const KEY key) const { return this->find(key) != this->end(); }
+  template <class K = KEY>
+  bool hasKey(const key_arg<K>& key) const {
+    return this->find(key) != this->end();
+  }
 
   /**
    * @brief Find the value corresponding to the key.
@@ -158,7 +219,9 @@ class HashMap : public absl::flat_hash_map<KEY, VALUE, HASH, EQ> {
    * @param default_value The default return value if not found.
    * @return const VALUE Return the found value.
    */
-  const VALUE value(const KEY key, const VALUE& default_value = VALUE()) const {
+  template <class K = KEY>
+  const VALUE value(const key_arg<K>& key,
+                    const VALUE& default_value = VALUE()) const {
     auto find_iter = this->find(key);
     if (find_iter != this->end()) {
       return find_iter->second;
@@ -168,17 +231,74 @@ class HashMap : public absl::flat_hash_map<KEY, VALUE, HASH, EQ> {
   }
 
   /**
-   * @brief Insert the (key, value) to the map container.
+   * @brief Find the values of many keys with the prefetch of the whole batch,
+   * it is faster than find one by one when the map is larger than the cache.
+   *
+   * @param keys The keys.
+   * @param num_keys The key number.
+   * @param values The found value of each key, nullptr if not found.
+   */
+  void findBatch(const KEY* keys, size_t num_keys, const VALUE** values) const {
+    lookupBatch(*this, keys, num_keys,
+                [this, values](size_t i, const_iterator iter) {
+                  values[i] = iter == this->end() ? nullptr : &iter->second;
+                });
+  }
+
+  /**
+   * @brief Find out if the keys are in the map with the prefetch of the whole
+   * batch.
+   *
+   * @param keys The keys.
+   * @param num_keys The key number.
+   * @param found Whether each key is in the map.
+   * @return size_t The number of the found keys.
+   */
+  size_t containsBatch(const KEY* keys, size_t num_keys, bool* found) const {
+    size_t num_found = 0;
+    lookupBatch(*this, keys, num_keys,
+                [this, found, &num_found](size_t i, const_iterator iter) {
+                  found[i] = iter != this->end();
+                  num_found += found[i];
+                });
+    return num_found;
+  }
+
+  /**
+   * @brief Scan the table for the probe length, see ContainerStats for the
+   * report of the whole process.
+   *
+   * @param site The name of the table in the statistics.
+   * @return HashTableStats
+   */
+  HashTableStats stats(const std::string& site = "") const {
+    return hashTableStats(*this, site);
+  }
+
+  /**
+   * @brief Insert the (key, value) to the map container, or assign the value
+   * if the key is existed.The arguments are forwarded, so the rvalue is moved
+   * and the heterogeneous key such as string view is only converted to KEY
+   * when it is inserted.
    *
    * @param key
    * @param value
    */
   void insert(const KEY& key, const VALUE& value) {
-    this->operator[](key) = value;
+    this->insert_or_assign(key, value);
   }
-
-  void insert(const KEY&& key, const VALUE&& value) {
-    this->operator[](std::move(key)) = std::move(value);
+  void insert(KEY&& key, VALUE&& value) {
+    this->insert_or_assign(std::move(key), std::move(value));
+  }
+  // The exact overloads above are preferred to the range insert of the base
+  // when KEY and VALUE are the same type.
+  template <class K = KEY, class V = VALUE,
+            typename std::enable_if<
+                std::is_constructible<KEY, K&&>::value &&
+                    std::is_constructible<VALUE, V&&>::value,
+                int>::type = 0>
+  void insert(K&& key, V&& value) {
+    this->insert_or_assign(std::forward<K>(key), std::forward<V>(value));
   }
 
   /**
@@ -371,7 +491,7 @@ class HashMultimap : public std::unordered_multimap<KEY, VALUE> {
    */
   std::list<KEY> keys() const {
     std::list<KEY> ret_value;
-    for (auto p : *this) {
+    for (const auto& p : *this) {
       ret_value.push_back(p.first);
     }
     return ret_value;
@@ -399,7 +519,7 @@ class HashMultimap : public std::unordered_multimap<KEY, VALUE> {
    * @return true if find out.
    * @return false
    */
-  bool hasKey(const KEY key) const { return this->find(key) != this->end(); }
+  bool hasKey(const KEY& key) const { return this->find(key) != this->end(); }
 
   /**
    * @brief Find the value corresponding to key.
@@ -408,7 +528,8 @@ class HashMultimap : public std::unordered_multimap<KEY, VALUE> {
    * @param default_value the default Return value if not found.
    * @return const VALUE Return the found value.
    */
-  const VALUE value(const KEY key, const VALUE& default_value = VALUE()) const {
+  const VALUE value(const KEY& key,
+                    const VALUE& default_value = VALUE()) const {
     auto find_iter = this->find(key);
     if (find_iter != this->end()) {
       return find_iter->second;
@@ -418,13 +539,27 @@ class HashMultimap : public std::unordered_multimap<KEY, VALUE> {
   }
 
   /**
-   * @brief Insert the (key, value) to the map container.
+   * @brief Insert the (key, value) to the map container, the arguments are
+   * forwarded.
    *
    * @param key
    * @param value
    */
   void insert(const KEY& key, const VALUE& value) {
-    this->operator[](key) = value;
+    this->emplace(key, value);
+  }
+  void insert(KEY&& key, VALUE&& value) {
+    this->emplace(std::move(key), std::move(value));
+  }
+  // The exact overloads above are preferred to the range insert of the base
+  // when KEY and VALUE are the same type.
+  template <class K = KEY, class V = VALUE,
+            typename std::enable_if<
+                std::is_constructible<KEY, K&&>::value &&
+                    std::is_constructible<VALUE, V&&>::value,
+                int>::type = 0>
+  void insert(K&& key, V&& value) {
+    this->emplace(std::forward<K>(key), std::forward<V>(value));
   }
 
   /**
@@ -11,9 +11,16 @@
 
 #pragma once
 
+#include <algorithm>
+#include <iterator>
+#include <string>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
+#include "HashBatch.h"
+#include "Parallel.h"
+#include "HashTableStats.h"
 #include "absl/container/flat_hash_set.h"
 
 namespace pcl {
@@ -34,6 +41,10 @@ class HashSet : public absl::flat_hash_set<KEY, HASH, EQ> {
   using value_type = typename Base::value_type;
   using hash = typename Base::hasher;
   using eq = typename Base::key_equal;
+  // The key type of heterogeneous lookup, it is K when the hash and eq are
+  // transparent, otherwise KEY.
+  template <class K>
+  using key_arg = typename Base::template key_arg<K>;
 
   /*constructor*/
   using Base::Base;
@@ -133,6 +144,137 @@ class HashSet : public absl::flat_hash_set<KEY, HASH, EQ> {
     return *this;
   }
 
+  /**
+   * @brief Find many keys with the prefetch of the whole batch, it is faster
+   * than find one by one when the set is larger than the cache.
+   *
+   * @param keys The keys.
+   * @param num_keys The key number.
+   * @param found The found element of each key, nullptr if not found.
+   */
+  void findBatch(const KEY* keys, size_t num_keys, const KEY** found) const {
+    lookupBatch(*this, keys, num_keys,
+                [this, found](size_t i, const_iterator iter) {
+                  found[i] = iter == this->end() ? nullptr : &*iter;
+                });
+  }
+
+  /**
+   * @brief Find out if the keys are in the set with the prefetch of the whole
+   * batch.
+   *
+   * @param keys The keys.
+   * @param num_keys The key number.
+   * @param found Whether each key is in the set.
+   * @return size_t The number of the found keys.
+   */
+  size_t containsBatch(const KEY* keys, size_t num_keys, bool* found) const {
+    size_t num_found = 0;
+    lookupBatch(*this, keys, num_keys,
+                [this, found, &num_found](size_t i, const_iterator iter) {
+                  found[i] = iter != this->end();
+                  num_found += found[i];
+                });
+    return num_found;
+  }
+
+  /**
+   * @brief Scan the table for the probe length, see ContainerStats for the
+   * report of the whole process.
+   *
+   * @param site The name of the table in the statistics.
+   * @return HashTableStats
+   */
+  HashTableStats stats(const std::string& site = "") const {
+    return hashTableStats(*this, site);
+  }
+
+  /**
+   * @brief The intersection of many sets.
+   *
+   * The sets are ordered by size, each item of the smallest set is looked up
+   * in the others from the smallest one and it stops at the first set missing
+   * it.The items of the smallest set are split among the threads, and the
+   * result is reserved and filled once.
+   *
+   * @param sets The sets, nullptr is the empty set.
+   * @param num_threads The thread number, zero or negative means the hardware
+   * concurrency.
+   * @return HashSet<KEY, HASH, EQ> The new set.
+   */
+  static HashSet<KEY, HASH, EQ> intersectAll(
+      const std::vector<const HashSet<KEY, HASH, EQ>*>& sets,
+      int num_threads = 1) {
+    std::vector<const HashSet<KEY, HASH, EQ>*> sorted_sets = sets;
+    std::stable_sort(
+        sorted_sets.begin(), sorted_sets.end(),
+        [](const HashSet<KEY, HASH, EQ>* a, const HashSet<KEY, HASH, EQ>* b) {
+          return (a ? a->size() : 0) < (b ? b->size() : 0);
+        });
+    HashSet<KEY, HASH, EQ> result;
+    if (sorted_sets.empty() || sorted_sets.front() == nullptr ||
+        sorted_sets.front()->empty()) {
+      return result;
+    }
+    std::vector<const KEY*> keys;
+    keys.reserve(sorted_sets.front()->size());
+    for (const KEY& key : *sorted_sets.front()) {
+      keys.push_back(&key);
+    }
+    std::vector<std::vector<const KEY*>> chunk_results(
+        std::max(num_threads <= 0 ? defaultThreadNum() : num_threads, 1));
+    parallelFor(keys.size(), num_threads,
+                [&](int chunk, size_t begin, size_t end) {
+                  for (size_t i = begin; i < end; ++i) {
+                    size_t j = 1;
+                    while (j < sorted_sets.size() &&
+                           sorted_sets[j]->contains(*keys[i])) {
+                      ++j;
+                    }
+                    if (j == sorted_sets.size()) {
+                      chunk_results[chunk].push_back(keys[i]);
+                    }
+                  }
+                });
+    size_t num_result = 0;
+    for (const auto& chunk : chunk_results) {
+      num_result += chunk.size();
+    }
+    result.reserve(num_result);
+    for (const auto& chunk : chunk_results) {
+      for (const KEY* key : chunk) {
+        result.insert(*key);
+      }
+    }
+    return result;
+  }
+
+  /**
+   * @brief The union of many sets.
+   *
+   * The result is reserved for the largest set and the sets are inserted one
+   * by one.The single table is filled by one thread, see ShardedHashSet for
+   * the union with multiple threads.
+   *
+   * @param sets The sets, nullptr is the empty set.
+   * @return HashSet<KEY, HASH, EQ> The new set.
+   */
+  static HashSet<KEY, HASH, EQ> uniteAll(
+      const std::vector<const HashSet<KEY, HASH, EQ>*>& sets) {
+    HashSet<KEY, HASH, EQ> result;
+    size_t max_size = 0;
+    for (const auto* set : sets) {
+      max_size = std::max(max_size, set ? set->size() : 0);
+    }
+    result.reserve(max_size);
+    for (const auto* set : sets) {
+      if (set) {
+        result.insert(set->begin(), set->end());
+      }
+    }
+    return result;
+  }
+
   /**
    * @brief Insert a value to the set.
    *
@@ -245,7 +387,8 @@ class HashSet : public absl::flat_hash_set<KEY, HASH, EQ> {
    * @return true when has key.
    * @return false when do not has key.
    */
-  bool hasKey(const KEY key) const {
+  template <class K = KEY>
+  bool hasKey(const key_arg<K>& key) const {
     auto find_iter = this->find(key);
     return find_iter != this->end();
   }
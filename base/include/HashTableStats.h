@@ -0,0 +1,91 @@
+/**
+ * @file HashTableStats.h
+ * @author simin tao (taosm@pcl.ac.cn)
+ * @brief The health statistics of one swiss table for the eda project.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <type_traits>
+
+#include "absl/container/internal/hashtable_debug.h"
+
+namespace pcl {
+
+/**
+ * @brief The health of one swiss table.
+ *
+ * The probe length of an element is the probe number of its lookup as the
+ * abseil debug hook counts it, one for each group skipped and each false
+ * match of the control byte, a well hashed table has the max probe length
+ * near zero.The tombstones and rehashes are not visible through the table
+ * interface, so they are not reported.
+ */
+struct HashTableStats {
+  std::string site;  // The allocation site, or the name given by the tracker.
+  size_t size = 0;
+  size_t capacity = 0;
+  size_t max_probe_length = 0;
+  size_t total_probe_length = 0;
+
+  double loadFactor() const {
+    return capacity == 0 ? 0.0 : static_cast<double>(size) / capacity;
+  }
+  double meanProbeLength() const {
+    return size == 0 ? 0.0 : static_cast<double>(total_probe_length) / size;
+  }
+};
+
+namespace detail {
+
+template <class TABLE, class = void>
+struct IsHashMapTable : std::false_type {};
+
+template <class TABLE>
+struct IsHashMapTable<TABLE, std::void_t<typename TABLE::mapped_type>>
+    : std::true_type {};
+
+}  // namespace detail
+
+/**
+ * @brief Scan the swiss table for the health statistics, each element is
+ * looked up once, the complexity is O(size).
+ *
+ * @tparam TABLE The HashMap, HashSet or other abseil flat/node hash table.
+ * @param table
+ * @param site The name of the table in the report.
+ * @return HashTableStats
+ */
+template <class TABLE>
+HashTableStats hashTableStats(const TABLE& table,
+                              const std::string& site = "") {
+  using Set = typename TABLE::raw_hash_set;
+  const Set& set = table;
+  HashTableStats stats;
+  stats.site = site;
+  stats.size = table.size();
+  stats.capacity = table.bucket_count();
+  for (const auto& element : set) {
+    size_t probe_length;
+    if constexpr (detail::IsHashMapTable<TABLE>::value) {
+      probe_length = absl::container_internal::GetHashtableDebugNumProbes(
+          set, element.first);
+    } else {
+      probe_length =
+          absl::container_internal::GetHashtableDebugNumProbes(set, element);
+    }
+    stats.max_probe_length = std::max(stats.max_probe_length, probe_length);
+    stats.total_probe_length += probe_length;
+  }
+  return stats;
+}
+
+}  // namespace pcl
@@ -0,0 +1,133 @@
+/**
+ * @file HashedKey.h
+ * @author simin tao (taosm@pcl.ac.cn)
+ * @brief The key with the precomputed hash for the eda project.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <utility>
+
+#include "HashMap.h"
+#include "HashSet.h"
+#include "absl/hash/hash.h"
+
+namespace pcl {
+
+/**
+ * @brief The key which stores its hash, so the hot key looked up in several
+ * hash containers is hashed only once, such as the long hierarchical net
+ * name.
+ *
+ * HashedKey<std::string> name(net_name);
+ * HashedKeyMap<std::string, Net*> net_map;
+ * HashedKeySet<std::string> dirty_nets;
+ * net_map.find(name);
+ * dirty_nets.contains(name);
+ *
+ * The hash is used by the swiss table directly, so HASH must be a well mixed
+ * hash such as absl::Hash.
+ *
+ * @tparam KEY
+ * @tparam HASH The hash of KEY.
+ */
+template <class KEY, class HASH = absl::Hash<KEY>>
+class HashedKey {
+ public:
+  using key_type = KEY;
+  using hasher = HASH;
+
+  HashedKey() : HashedKey(KEY()) {}
+  HashedKey(const KEY& key) : _key(key), _hash(HASH()(_key)) {}  // NOLINT
+  HashedKey(KEY&& key) : _key(std::move(key)), _hash(HASH()(_key)) {}  // NOLINT
+  /**
+   * @brief Construct with the hash computed before, the hash must be equal
+   * to HASH()(key).
+   */
+  HashedKey(KEY key, size_t hash) : _key(std::move(key)), _hash(hash) {}
+  ~HashedKey() = default;
+
+  HashedKey(const HashedKey&) = default;
+  HashedKey(HashedKey&&) = default;
+  HashedKey& operator=(const HashedKey&) = default;
+  HashedKey& operator=(HashedKey&&) = default;
+
+  const KEY& key() const { return _key; }
+  size_t hash() const { return _hash; }
+
+  /**
+   * @brief The keys of different hash are different, so the key comparison
+   * of the long name is skipped mostly.
+   */
+  friend bool operator==(const HashedKey& lhs, const HashedKey& rhs) {
+    return lhs._hash == rhs._hash && lhs._key == rhs._key;
+  }
+  friend bool operator!=(const HashedKey& lhs, const HashedKey& rhs) {
+    return !(lhs == rhs);
+  }
+
+  /**
+   * @brief Make the hashed key usable with the default hash of the
+   * containers, only the stored hash is mixed.
+   */
+  template <typename H>
+  friend H AbslHashValue(H h, const HashedKey& key) {
+    return H::combine(std::move(h), key._hash);
+  }
+
+ private:
+  KEY _key;
+  size_t _hash;
+};
+
+/**
+ * @brief The hasher adaptor returning the stored hash without any work, the
+ * plain key is hashed by HASH for the heterogeneous lookup.
+ */
+template <class KEY, class HASH = absl::Hash<KEY>>
+struct HashedKeyHash {
+  using is_transparent = void;
+
+  size_t operator()(const HashedKey<KEY, HASH>& key) const {
+    return key.hash();
+  }
+  size_t operator()(const KEY& key) const { return HASH()(key); }
+};
+
+/**
+ * @brief The equal adaptor comparing the stored hash first, the plain key is
+ * accepted for the heterogeneous lookup.
+ */
+template <class KEY, class HASH = absl::Hash<KEY>>
+struct HashedKeyEq {
+  using is_transparent = void;
+
+  bool operator()(const HashedKey<KEY, HASH>& lhs,
+                  const HashedKey<KEY, HASH>& rhs) const {
+    return lhs == rhs;
+  }
+  bool operator()(const HashedKey<KEY, HASH>& lhs, const KEY& rhs) const {
+    return lhs.key() == rhs;
+  }
+  bool operator()(const KEY& lhs, const HashedKey<KEY, HASH>& rhs) const {
+    return lhs == rhs.key();
+  }
+};
+
+// The hash containers keyed by the hashed key, the plain key can be looked up
+// too.
+template <class KEY, class VALUE, class HASH = absl::Hash<KEY>>
+using HashedKeyMap = HashMap<HashedKey<KEY, HASH>, VALUE,
+                             HashedKeyHash<KEY, HASH>, HashedKeyEq<KEY, HASH>>;
+
+template <class KEY, class HASH = absl::Hash<KEY>>
+using HashedKeySet = HashSet<HashedKey<KEY, HASH>, HashedKeyHash<KEY, HASH>,
+                             HashedKeyEq<KEY, HASH>>;
+
+}  // namespace pcl
@@ -0,0 +1,268 @@
+/**
+ * @file IntervalMap.h
+ * @author simin tao (taosm@pcl.ac.cn)
+ * @brief The interval map container for the eda project.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#pragma once
+
+#include <functional>
+#include <iterator>
+#include <utility>
+
+#include "Map.h"
+#include "RangeView.h"
+
+namespace pcl {
+
+/**
+ * @brief A map from the half open intervals [lo, hi) to the values, such as
+ * the timing windows, the row segment occupancy and the routing track usage.
+ *
+ * The map keeps the disjoint segments in the btree Map keyed by the segment
+ * start, and the touching segments of the equal value are coalesced, so the
+ * map is the minimal segment list of the piecewise value.The assign overwrites
+ * the value of an interval, and the add accumulates the value by operator+=,
+ * the overlapped part of two added intervals gets the sum, e.g. the track
+ * usage.The stabbing query finds the segment containing a point, and the
+ * overlap query visits the segments intersecting an interval, both in
+ * O(log n + k).
+ *
+ * IntervalMap<int, int> track_usage;
+ * track_usage.add(0, 100, 1);
+ * track_usage.add(50, 200, 1);
+ * for (auto& [lo, segment] : track_usage.overlap(40, 60)) {
+ *   // [40, 50) is used once, [50, 60) twice.
+ * }
+ *
+ * @tparam KEY The interval bound.
+ * @tparam VALUE The value of the interval, it is equality comparable.
+ * @tparam CMP
+ */
+template <class KEY, class VALUE, class CMP = std::less<KEY>>
+class IntervalMap {
+ public:
+  /**
+   * @brief The segment [start, end) stored as the item (start, segment).
+   */
+  struct Segment {
+    KEY end;
+    VALUE value;
+  };
+  using Segments = Map<KEY, Segment, CMP>;
+  using key_type = KEY;
+  using mapped_type = VALUE;
+  using iterator = typename Segments::const_iterator;
+  using const_iterator = typename Segments::const_iterator;
+
+  IntervalMap() = default;
+  explicit IntervalMap(const CMP& comp) : _segments(comp), _comp(comp) {}
+  ~IntervalMap() = default;
+
+  const_iterator begin() const { return _segments.begin(); }
+  const_iterator end() const { return _segments.end(); }
+
+  /**
+   * @brief The segment number after coalescing.
+   */
+  size_t size() const { return _segments.size(); }
+  bool empty() const { return _segments.empty(); }
+  void clear() { _segments.clear(); }
+
+  /**
+   * @brief Set the value of [lo, hi), the old values in it are overwritten.
+   *
+   * @param lo
+   * @param hi
+   * @param value
+   */
+  void assign(const KEY& lo, const KEY& hi, const VALUE& value) {
+    if (!_comp(lo, hi)) {
+      return;
+    }
+    split(lo);
+    split(hi);
+    auto iter = _segments.erase(_segments.lower_bound(lo),
+                                _segments.lower_bound(hi));
+    _segments.emplace_hint(iter, lo, Segment{hi, value});
+    coalesce(lo, hi);
+  }
+
+  /**
+   * @brief Accumulate the value to [lo, hi) by operator+=, the part not
+   * covered before gets the value.
+   *
+   * @param lo
+   * @param hi
+   * @param value
+   */
+  void add(const KEY& lo, const KEY& hi, const VALUE& value) {
+    if (!_comp(lo, hi)) {
+      return;
+    }
+    split(lo);
+    split(hi);
+    KEY pos = lo;
+    auto iter = _segments.lower_bound(lo);
+    while (_comp(pos, hi)) {
+      if (iter == _segments.end() || !_comp(iter->first, hi)) {
+        _segments.emplace_hint(iter, pos, Segment{hi, value});
+        break;
+      }
+      if (_comp(pos, iter->first)) {
+        // Fill the gap before the segment, the insert invalidates iter.
+        iter = _segments.emplace_hint(iter, pos, Segment{iter->first, value});
+        ++iter;
+      }
+      iter->second.value += value;
+      pos = iter->second.end;
+      ++iter;
+    }
+    coalesce(lo, hi);
+  }
+
+  /**
+   * @brief Remove [lo, hi) from the map, the segments crossing the bounds
+   * are cut.
+   *
+   * @param lo
+   * @param hi
+   */
+  void erase(const KEY& lo, const KEY& hi) {
+    if (!_comp(lo, hi)) {
+      return;
+    }
+    split(lo);
+    split(hi);
+    _segments.erase(_segments.lower_bound(lo), _segments.lower_bound(hi));
+  }
+
+  /**
+   * @brief The stabbing query, find the segment containing the point.
+   *
+   * @param point
+   * @return const_iterator The segment, end() if not found.
+   */
+  const_iterator find(const KEY& point) const {
+    auto iter = _segments.upper_bound(point);
+    if (iter == _segments.begin()) {
+      return _segments.end();
+    }
+    --iter;
+    return _comp(point, iter->second.end) ? iter : _segments.end();
+  }
+
+  bool contains(const KEY& point) const { return find(point) != end(); }
+
+  /**
+   * @brief Find the value at the point.
+   *
+   * @param point
+   * @param default_value the default return value if not found.
+   * @return const VALUE return the found value.
+   */
+  const VALUE value(const KEY& point,
+                    const VALUE& default_value = VALUE()) const {
+    auto iter = find(point);
+    return iter != end() ? iter->second.value : default_value;
+  }
+
+  /**
+   * @brief The overlap query, the segments intersecting [lo, hi) in order.
+   *
+   * @param lo
+   * @param hi
+   * @return IteratorRange<const_iterator> The segments valid until the map is
+   * modified.
+   */
+  IteratorRange<const_iterator> overlap(const KEY& lo, const KEY& hi) const {
+    if (!_comp(lo, hi)) {
+      return {end(), end(), 0};
+    }
+    auto first = _segments.lower_bound(lo);
+    if (first != _segments.begin()) {
+      auto prev = std::prev(first);
+      if (_comp(lo, prev->second.end)) {
+        first = prev;
+      }
+    }
+    auto last = _segments.lower_bound(hi);
+    return {first, last, static_cast<size_t>(std::distance(first, last))};
+  }
+
+  /**
+   * @brief Judge whether any segment intersects [lo, hi).
+   */
+  bool overlaps(const KEY& lo, const KEY& hi) const {
+    return !overlap(lo, hi).empty();
+  }
+
+  friend bool operator==(const IntervalMap& lhs, const IntervalMap& rhs) {
+    if (lhs.size() != rhs.size()) {
+      return false;
+    }
+    auto iter = rhs.begin();
+    for (const auto& p : lhs) {
+      if (!lhs.equalKey(p.first, iter->first) ||
+          !lhs.equalKey(p.second.end, iter->second.end) ||
+          !(p.second.value == iter->second.value)) {
+        return false;
+      }
+      ++iter;
+    }
+    return true;
+  }
+  friend bool operator!=(const IntervalMap& lhs, const IntervalMap& rhs) {
+    return !(lhs == rhs);
+  }
+
+ private:
+  bool equalKey(const KEY& a, const KEY& b) const {
+    return !_comp(a, b) && !_comp(b, a);
+  }
+
+  // Cut the segment crossing the point into two at the point.
+  void split(const KEY& point) {
+    auto iter = _segments.upper_bound(point);
+    if (iter == _segments.begin()) {
+      return;
+    }
+    --iter;
+    if (_comp(iter->first, point) && _comp(point, iter->second.end)) {
+      Segment tail{iter->second.end, iter->second.value};
+      iter->second.end = point;
+      _segments.emplace_hint(std::next(iter), point, std::move(tail));
+    }
+  }
+
+  // Coalesce the touching segments of the equal value from the segment
+  // before lo to the segment starting at hi.The btree erase invalidates the
+  // iterators, so the iterator is taken from its result.
+  void coalesce(const KEY& lo, const KEY& hi) {
+    auto iter = _segments.lower_bound(lo);
+    if (iter != _segments.begin()) {
+      --iter;
+    }
+    while (iter != _segments.end() && !_comp(hi, iter->first)) {
+      auto next = std::next(iter);
+      if (next != _segments.end() &&
+          equalKey(iter->second.end, next->first) &&
+          iter->second.value == next->second.value) {
+        iter->second.end = next->second.end;
+        iter = std::prev(_segments.erase(next));
+      } else {
+        iter = next;
+      }
+    }
+  }
+
+  Segments _segments;
+  CMP _comp;
+};
+
+}  // namespace pcl
@@ -0,0 +1,34 @@
+/**
+ * @file KeyOf.h
+ * @author simin tao (taosm@pcl.ac.cn)
+ * @brief The key extractors of the tree containers for the eda project.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#pragma once
+
+namespace pcl {
+namespace detail {
+
+// The key of the set item is the item itself.
+struct IdentityKey {
+  template <class T>
+  const T& operator()(const T& item) const {
+    return item;
+  }
+};
+
+// The key of the map item is the first of the pair.
+struct PairFirstKey {
+  template <class PAIR>
+  const typename PAIR::first_type& operator()(const PAIR& item) const {
+    return item.first;
+  }
+};
+
+}  // namespace detail
+}  // namespace pcl
@@ -11,6 +11,7 @@
 #pragma once
 #include <algorithm>
 #include <list>
+#include <utility>
 
 #include "absl/algorithm/algorithm.h"
 namespace pcl {
@@ -71,20 +72,29 @@ class List : public std::list<T> {
    * @brief Returns a List that contains all the items in List val1
    * followed by all the items in the List val2.
    *
+   * The temporary operand is reused, the nodes of the temporary val2 are
+   * spliced without copy.
+   *
    * @param val1
    * @param val2
-   * @return List<T>&
+   * @return List<T> The new list.
    */
-  friend List<T>& operator+(const List<T>& val1, const List<T>& val2) {
-    List<T>* ret_val = new List<T>;
-
-    for (List<T>::const_iterator it1 = val1.begin(); it1 != val1.end(); it1++) {
-      ret_val->push_back(*it1);
-    }
-    for (List<T>::const_iterator it2 = val2.begin(); it2 != val2.end(); it2++) {
-      ret_val->push_back(*it2);
-    }
-    return *ret_val;
+  friend List<T> operator+(const List<T>& val1, const List<T>& val2) {
+    List<T> ret_val(val1);
+    ret_val.insert(ret_val.end(), val2.begin(), val2.end());
+    return ret_val;
+  }
+  friend List<T> operator+(List<T>&& val1, const List<T>& val2) {
+    val1.insert(val1.end(), val2.begin(), val2.end());
+    return std::move(val1);
+  }
+  friend List<T> operator+(const List<T>& val1, List<T>&& val2) {
+    val2.insert(val2.begin(), val1.begin(), val1.end());
+    return std::move(val2);
+  }
+  friend List<T> operator+(List<T>&& val1, List<T>&& val2) {
+    val1.splice(val1.end(), val2);
+    return std::move(val1);
   }
   /**
    * @brief Returns the vectorList val1 followed by all the items in the List
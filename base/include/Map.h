@@ -11,10 +11,16 @@
 
 #pragma once
 
+#include <algorithm>
 #include <functional>
 #include <list>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
+#include "Parallel.h"
+#include "RangeView.h"
+#include "Vector.h"
 #include "absl/container/btree_map.h"
 
 namespace pcl {
@@ -47,6 +53,13 @@ class Map : public absl::btree_map<KEY, VALUE, CMP> {
   using const_reverse_iterator = typename Base::const_reverse_iterator;
   using size_type = typename Base::size_type;
   using value_type = typename Base::value_type;
+  // The key type of heterogeneous lookup, it is K when the comparator is
+  // transparent, otherwise KEY.The protected key_arg of the btree container is
+  // not reused, gcc recurses infinitely substituting it in a derived class.
+  template <class K>
+  using key_arg = typename absl::container_internal::KeyArg<
+      absl::container_internal::IsTransparent<
+          typename Base::key_compare>::value>::template type<K, KEY>;
 
   /*constructor and destructor*/
   using Base::Base;
@@ -102,6 +115,42 @@ class Map : public absl::btree_map<KEY, VALUE, CMP> {
   template <typename K, typename V, typename C>
   friend bool operator<(const Map<K, V, C>&, const Map<K, V, C>&);
 
+  /**
+   * @brief Build the map from the items [first, last) sorted by key in O(n).
+   *
+   * Each item is appended at the end of the tree by the hint, so there is no
+   * descent from the root, and the btree splits the rightmost node leaving
+   * the left one full, so the nodes are filled full as the bottom up build.
+   *
+   * @tparam ITER The input iterator.
+   * @param first
+   * @param last
+   * @return Map<KEY, VALUE, CMP> The new map.
+   */
+  template <class ITER>
+  static Map<KEY, VALUE, CMP> fromSorted(ITER first, ITER last) {
+    Map<KEY, VALUE, CMP> result;
+    result.appendSorted(first, last);
+    return result;
+  }
+
+  /**
+   * @brief Append the items [first, last) sorted by key, the keys are not
+   * less than the keys in the map, such as the monotone keys read from the
+   * sorted file.The item breaking the order is still inserted correctly,
+   * only without the speed up.For the equal keys, the first item is kept.
+   *
+   * @tparam ITER The input iterator.
+   * @param first
+   * @param last
+   */
+  template <class ITER>
+  void appendSorted(ITER first, ITER last) {
+    for (; first != last; ++first) {
+      this->emplace_hint(this->end(), *first);
+    }
+  }
+
   /**
    * @brief Get all mapped keys.
    *
@@ -109,7 +158,7 @@ class Map : public absl::btree_map<KEY, VALUE, CMP> {
    */
   std::list<KEY> keys() const {
     std::list<KEY> ret_value;
-    for (auto p : *this) {
+    for (const auto& p : *this) {
       ret_value.push_back(p.first);
     }
     return ret_value;
@@ -122,12 +171,58 @@ class Map : public absl::btree_map<KEY, VALUE, CMP> {
    */
   std::list<VALUE> values() const {
     std::list<VALUE> ret_value;
-    for (auto p : *this) {
+    for (const auto& p : *this) {
       ret_value.push_back(p.second);
     }
     return ret_value;
   }
 
+  /**
+   * @brief Get the lazy view of all keys, nothing is copied or allocated.
+   *
+   * @return IteratorRange The keys range valid until the map is modified.
+   */
+  IteratorRange<KeyIterator<const_iterator>> keysView() const {
+    return makeKeysView(*this);
+  }
+
+  /**
+   * @brief Get the lazy view of all values, the value can be modified through
+   * the view of the non const map.
+   *
+   * @return IteratorRange The values range valid until the map is modified.
+   */
+  IteratorRange<ValueIterator<iterator>> valuesView() {
+    return makeValuesView(*this);
+  }
+  IteratorRange<ValueIterator<const_iterator>> valuesView() const {
+    return makeValuesView(*this);
+  }
+
+  /**
+   * @brief Append all keys to the vector with one reservation.
+   *
+   * @param keys The vector of keys.
+   */
+  void keysInto(Vector<KEY>* keys) const {
+    keys->reserve(keys->size() + this->size());
+    for (const auto& p : *this) {
+      keys->push_back(p.first);
+    }
+  }
+
+  /**
+   * @brief Append all values to the vector with one reservation.
+   *
+   * @param values The vector of values.
+   */
+  void valuesInto(Vector<VALUE>* values) const {
+    values->reserve(values->size() + this->size());
+    for (const auto& p : *this) {
+      values->push_back(p.second);
+    }
+  }
+
   /**
    * @brief Judge whether the key is in the map.
    *
@@ -135,7 +230,10 @@ class Map : public absl::btree_map<KEY, VALUE, CMP> {
    * @return true if find out.
    * @return false
    */
-  bool hasKey(const KEY key) const { return this->find(key) != this->end(); }
+  template <class K = KEY>
+  bool hasKey(const key_arg<K>& key) const {
+    return this->find(key) != this->end();
+  }
 
   /**
    * @brief Find the value corresponding to key.
@@ -144,7 +242,9 @@ class Map : public absl::btree_map<KEY, VALUE, CMP> {
    * @param default_value the default return value if not found.
    * @return const VALUE return the found value.
    */
-  const VALUE value(const KEY key, const VALUE& default_value = VALUE()) const {
+  template <class K = KEY>
+  const VALUE value(const key_arg<K>& key,
+                    const VALUE& default_value = VALUE()) const {
     auto find_iter = this->find(key);
     if (find_iter != this->end()) {
       return find_iter->second;
@@ -154,17 +254,28 @@ class Map : public absl::btree_map<KEY, VALUE, CMP> {
   }
 
   /**
-   * @brief Insert the (key, value) to the map container.
+   * @brief Insert the (key, value) to the map container, or assign the value
+   * if the key is existed.The arguments are forwarded, so the rvalue is moved
+   * and the heterogeneous key is only converted to KEY when it is inserted.
    *
    * @param key The key to be found.
    * @param value The value to be found.
    */
   void insert(const KEY& key, const VALUE& value) {
-    this->operator[](key) = value;
+    this->insert_or_assign(key, value);
   }
-
   void insert(KEY&& key, VALUE&& value) {
-    this->operator[](std::move(key)) = std::move(value);
+    this->insert_or_assign(std::move(key), std::move(value));
+  }
+  // The exact overloads above are preferred to the range insert of the base
+  // when KEY and VALUE are the same type.
+  template <class K = KEY, class V = VALUE,
+            typename std::enable_if<
+                std::is_constructible<KEY, K&&>::value &&
+                    std::is_constructible<VALUE, V&&>::value,
+                int>::type = 0>
+  void insert(K&& key, V&& value) {
+    this->insert_or_assign(std::forward<K>(key), std::forward<V>(value));
   }
 
   /**
@@ -332,6 +443,13 @@ class Multimap : public absl::btree_multimap<KEY, VALUE, CMP> {
   using reverse_iterator = typename Base::reverse_iterator;
   using const_reverse_iterator = typename Base::const_reverse_iterator;
   using value_type = typename Base::value_type;
+  // The key type of heterogeneous lookup, it is K when the comparator is
+  // transparent, otherwise KEY.The protected key_arg of the btree container is
+  // not reused, gcc recurses infinitely substituting it in a derived class.
+  template <class K>
+  using key_arg = typename absl::container_internal::KeyArg<
+      absl::container_internal::IsTransparent<
+          typename Base::key_compare>::value>::template type<K, KEY>;
 
   /*constructor*/
   using Base::Base;
@@ -385,13 +503,63 @@ class Multimap : public absl::btree_multimap<KEY, VALUE, CMP> {
   friend bool operator<(const Multimap<K, V, C>&, const Multimap<K, V, C>&);
 
   /**
-   * @brief Insert the (key, value) to the map container.
+   * @brief Insert the (key, value) to the map container, the arguments are
+   * forwarded.
    *
    * @param key
    * @param value
    */
   void insert(const KEY& key, const VALUE& value) {
-    insert(value_type(key, value));
+    this->emplace(key, value);
+  }
+  void insert(KEY&& key, VALUE&& value) {
+    this->emplace(std::move(key), std::move(value));
+  }
+  // The exact overloads above are preferred to the range insert of the base
+  // when KEY and VALUE are the same type.
+  template <class K = KEY, class V = VALUE,
+            typename std::enable_if<
+                std::is_constructible<KEY, K&&>::value &&
+                    std::is_constructible<VALUE, V&&>::value,
+                int>::type = 0>
+  void insert(K&& key, V&& value) {
+    this->emplace(std::forward<K>(key), std::forward<V>(value));
+  }
+
+  /**
+   * @brief Build the map from the items [first, last) sorted by key in O(n).
+   *
+   * Each item is appended at the end of the tree by the hint, so there is no
+   * descent from the root, and the btree splits the rightmost node leaving
+   * the left one full, so the nodes are filled full as the bottom up build.
+   *
+   * @tparam ITER The input iterator.
+   * @param first
+   * @param last
+   * @return Multimap<KEY, VALUE, CMP> The new map.
+   */
+  template <class ITER>
+  static Multimap<KEY, VALUE, CMP> fromSorted(ITER first, ITER last) {
+    Multimap<KEY, VALUE, CMP> result;
+    result.appendSorted(first, last);
+    return result;
+  }
+
+  /**
+   * @brief Append the items [first, last) sorted by key, the keys are not
+   * less than the keys in the map, such as the monotone keys read from the
+   * sorted file.The item breaking the order is still inserted correctly,
+   * only without the speed up.The items of the equal key keep their order.
+   *
+   * @tparam ITER The input iterator.
+   * @param first
+   * @param last
+   */
+  template <class ITER>
+  void appendSorted(ITER first, ITER last) {
+    for (; first != last; ++first) {
+      this->emplace_hint(this->end(), *first);
+    }
   }
 
   /**
@@ -400,8 +568,9 @@ class Multimap : public absl::btree_multimap<KEY, VALUE, CMP> {
    * @param key
    * @return std::list<VALUE>
    */
-  std::list<VALUE> values(const KEY& key) {
-    auto ret_values = equal_range(key);
+  template <class K = KEY>
+  std::list<VALUE> values(const key_arg<K>& key) {
+    auto ret_values = this->equal_range(key);
     std::list<VALUE> ret_list;
     for (auto i = ret_values.first; i != ret_values.second; ++i) {
       ret_list.push_back(i->second);
@@ -410,6 +579,58 @@ class Multimap : public absl::btree_multimap<KEY, VALUE, CMP> {
     return ret_list;
   }
 
+  /**
+   * @brief Visit the groups of the equal key in key order by one linear pass,
+   * the func(key, values) is called once for each key, values is the view of
+   * the mapped values of the key in insertion order.
+   *
+   * Unlike the equal_range for each key, there is no descent from the root,
+   * the iterator only moves forward through the leaves.The values can be
+   * modified through the view of the non const map.
+   *
+   * net_pins.forEachGroup([](Net* net, auto pins) {
+   *   for (Pin* pin : pins) {
+   *     ...
+   *   }
+   * });
+   *
+   * @tparam FUNC The callable type of void(const KEY&, IteratorRange).
+   * @param func
+   */
+  template <class FUNC>
+  void forEachGroup(FUNC&& func) {
+    visitGroups(this->begin(), this->end(), this->key_comp(), func);
+  }
+  template <class FUNC>
+  void forEachGroup(FUNC&& func) const {
+    visitGroups(this->begin(), this->end(), this->key_comp(), func);
+  }
+
+  /**
+   * @brief Visit the groups of the equal key with multiple threads.
+   *
+   * The map is split into the key ranges of about the same item number, the
+   * range bound is moved forward to the first item of the next key, so no
+   * group is split, and each thread visits the groups of its range in key
+   * order.The func is called concurrently for the different keys, so it must
+   * be thread safe.The bounds are found by one serial walk of the items
+   * before the visit, which costs about a plain iteration of the map, so it
+   * only pays off when the func costs much more than stepping the iterator.
+   *
+   * @tparam FUNC The callable type of void(const KEY&, IteratorRange).
+   * @param num_threads The thread number, zero or negative means the hardware
+   * concurrency.
+   * @param func
+   */
+  template <class FUNC>
+  void forEachGroup(int num_threads, FUNC&& func) {
+    visitGroupsParallel(*this, num_threads, func);
+  }
+  template <class FUNC>
+  void forEachGroup(int num_threads, FUNC&& func) const {
+    visitGroupsParallel(*this, num_threads, func);
+  }
+
   /**
    * @brief Java style container itererator.
    *
@@ -506,6 +727,67 @@ class Multimap : public absl::btree_multimap<KEY, VALUE, CMP> {
     typename Multimap<KEY, VALUE, CMP>::const_iterator _iter;
   };
   friend class ConstIterator;
+
+ private:
+  // Call the func for each key group in [first, last), first is the first
+  // item of its key.
+  template <class ITER, class FUNC>
+  static void visitGroups(ITER first, ITER last, const CMP& comp,
+                          FUNC& func) {
+    while (first != last) {
+      ITER group_end = first;
+      size_t group_size = 0;
+      do {
+        ++group_end;
+        ++group_size;
+      } while (group_end != last && !comp(first->first, group_end->first));
+      func(first->first,
+           IteratorRange<ValueIterator<ITER>>(ValueIterator<ITER>(first),
+                                              ValueIterator<ITER>(group_end),
+                                              group_size));
+      first = group_end;
+    }
+  }
+
+  template <class MAP, class FUNC>
+  static void visitGroupsParallel(MAP& map, int num_threads, FUNC& func) {
+    using Iter = decltype(map.begin());
+    if (num_threads <= 0) {
+      num_threads = defaultThreadNum();
+    }
+    size_t size = map.size();
+    size_t num_chunks = std::min<size_t>(num_threads, size);
+    if (num_chunks <= 1) {
+      visitGroups(map.begin(), map.end(), map.key_comp(), func);
+      return;
+    }
+    // The chunk c visits [bounds[c], bounds[c + 1]), the bounds are found by
+    // walking forward once, without the lookup from the root.
+    auto comp = map.key_comp();
+    std::vector<Iter> bounds{map.begin()};
+    Iter iter = map.begin();
+    size_t index = 0;
+    for (size_t c = 1; c < num_chunks; ++c) {
+      for (; index < c * size / num_chunks; ++index) {
+        ++iter;
+      }
+      while (iter != map.end() && iter != bounds.back() &&
+             !comp(std::prev(iter)->first, iter->first)) {
+        ++iter;
+        ++index;
+      }
+      bounds.push_back(iter);
+    }
+    bounds.push_back(map.end());
+
+    parallelFor(num_chunks, static_cast<int>(num_chunks),
+                [&](int, size_t first_chunk, size_t last_chunk) {
+                  for (size_t c = first_chunk; c < last_chunk; ++c) {
+                    visitGroups(bounds[c], bounds[c + 1], map.key_comp(),
+                                func);
+                  }
+                });
+  }
 };
 
 template <typename KEY, typename VALUE, typename CMP>
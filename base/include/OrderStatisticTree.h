@@ -0,0 +1,641 @@
+/**
+ * @file OrderStatisticTree.h
+ * @author simin tao (taosm@pcl.ac.cn)
+ * @brief The order statistic btree map and set for the eda project.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "KeyOf.h"
+
+namespace pcl {
+
+namespace detail {
+
+/**
+ * @brief The B+ tree whose internal node keeps the item count of each child,
+ * so the rank of a key and the item of a rank are found in one descent.
+ *
+ * The items are in the leaves linked in order.The internal node keeps the
+ * children, the item count of each child, and the separator keys, the
+ * separator j is not greater than the keys of the child j + 1 and greater
+ * than the keys of the child j, it is not updated on erase since it keeps
+ * routing correctly.The node is split when full.The node less than half
+ * full is merged with the sibling when the two fit in one node, or else it
+ * takes the items from the sibling, so each node but the root is at least
+ * half full.
+ *
+ * @tparam KEY
+ * @tparam ITEM The stored item, KEY or the (KEY, VALUE) pair.
+ * @tparam KEY_OF The callable type of const KEY&(const ITEM&).
+ * @tparam CMP
+ */
+template <class KEY, class ITEM, class KEY_OF, class CMP>
+class OrderStatisticTree {
+ public:
+  using key_type = KEY;
+  using value_type = ITEM;
+  using key_compare = CMP;
+  using size_type = size_t;
+
+  // The max item number of the leaf and the max child number of the internal
+  // node.
+  static constexpr size_t kNodeSize = 64;
+
+ private:
+  struct Node {
+    explicit Node(bool is_leaf) : leaf(is_leaf) {}
+    bool leaf;
+    std::vector<ITEM> items;  // The leaf items.
+    Node* next = nullptr;     // The next leaf.
+    std::vector<KEY> keys;    // The separators of the internal node.
+    std::vector<std::unique_ptr<Node>> children;
+    std::vector<size_t> counts;  // The item count of each child.
+
+    size_t size() const { return leaf ? items.size() : children.size(); }
+  };
+  // The internal node and the child index on the path from the root.
+  using Path = std::vector<std::pair<Node*, size_t>>;
+
+ public:
+  /**
+   * @brief The forward iterator in the key order.
+   */
+  class const_iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = ITEM;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const ITEM*;
+    using reference = const ITEM&;
+
+    const_iterator() = default;
+    const_iterator(const Node* leaf, size_t index)
+        : _leaf(leaf), _index(index) {}
+
+    reference operator*() const { return _leaf->items[_index]; }
+    pointer operator->() const { return &_leaf->items[_index]; }
+    const_iterator& operator++() {
+      if (++_index == _leaf->items.size()) {
+        _leaf = _leaf->next;
+        _index = 0;
+      }
+      return *this;
+    }
+    const_iterator operator++(int) {
+      const_iterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+    bool operator==(const const_iterator& o) const {
+      return _leaf == o._leaf && _index == o._index;
+    }
+    bool operator!=(const const_iterator& o) const { return !(*this == o); }
+
+   private:
+    const Node* _leaf = nullptr;
+    size_t _index = 0;
+  };
+  using iterator = const_iterator;
+
+  OrderStatisticTree() = default;
+  explicit OrderStatisticTree(const CMP& comp) : _comp(comp) {}
+  ~OrderStatisticTree() = default;
+  OrderStatisticTree(const OrderStatisticTree& other)
+      : _comp(other._comp), _size(other._size) {
+    Node* prev_leaf = nullptr;
+    if (other._root) {
+      _root = clone(*other._root, &prev_leaf);
+    }
+  }
+  OrderStatisticTree(OrderStatisticTree&& other) noexcept
+      : _root(std::move(other._root)),
+        _comp(std::move(other._comp)),
+        _size(other._size) {
+    other._size = 0;
+  }
+  OrderStatisticTree& operator=(const OrderStatisticTree& other) {
+    if (this != &other) {
+      OrderStatisticTree copy(other);
+      swap(copy);
+    }
+    return *this;
+  }
+  OrderStatisticTree& operator=(OrderStatisticTree&& other) noexcept {
+    if (this != &other) {
+      _root = std::move(other._root);
+      _comp = std::move(other._comp);
+      _size = other._size;
+      other._size = 0;
+    }
+    return *this;
+  }
+
+  const_iterator begin() const {
+    const Node* node = _root.get();
+    if (node == nullptr) {
+      return end();
+    }
+    while (!node->leaf) {
+      node = node->children.front().get();
+    }
+    return const_iterator(node, 0);
+  }
+  const_iterator end() const { return const_iterator(); }
+
+  size_t size() const { return _size; }
+  bool empty() const { return _size == 0; }
+  void clear() {
+    _root.reset();
+    _size = 0;
+  }
+  void swap(OrderStatisticTree& other) {
+    std::swap(_root, other._root);
+    std::swap(_comp, other._comp);
+    std::swap(_size, other._size);
+  }
+  key_compare key_comp() const { return _comp; }
+
+  const_iterator find(const KEY& key) const {
+    if (!_root) {
+      return end();
+    }
+    const Node* node = _root.get();
+    while (!node->leaf) {
+      node = node->children[childIndex(*node, key)].get();
+    }
+    size_t index = itemIndex(*node, key);
+    if (index < node->items.size() &&
+        !_comp(key, KEY_OF()(node->items[index]))) {
+      return const_iterator(node, index);
+    }
+    return end();
+  }
+  bool contains(const KEY& key) const { return find(key) != end(); }
+  bool hasKey(const KEY& key) const { return contains(key); }
+  size_t count(const KEY& key) const { return contains(key) ? 1 : 0; }
+
+  /**
+   * @brief The number of the keys less than key, O(log n).
+   *
+   * @param key
+   * @return size_t The rank, it is the index of the key if existed.
+   */
+  size_t rank(const KEY& key) const {
+    if (!_root) {
+      return 0;
+    }
+    size_t rank = 0;
+    const Node* node = _root.get();
+    while (!node->leaf) {
+      size_t i = childIndex(*node, key);
+      for (size_t j = 0; j < i; ++j) {
+        rank += node->counts[j];
+      }
+      node = node->children[i].get();
+    }
+    return rank + itemIndex(*node, key);
+  }
+
+  /**
+   * @brief The item of the rank k in the key order, O(log n).
+   *
+   * @param k The zero based rank.
+   * @return const_iterator The item, end() if k >= size().
+   */
+  const_iterator select(size_t k) const {
+    if (k >= _size) {
+      return end();
+    }
+    const Node* node = _root.get();
+    while (!node->leaf) {
+      size_t i = 0;
+      while (k >= node->counts[i]) {
+        k -= node->counts[i++];
+      }
+      node = node->children[i].get();
+    }
+    return const_iterator(node, k);
+  }
+
+  /**
+   * @brief The number of the keys in [lo, hi), O(log n).
+   */
+  size_t countRange(const KEY& lo, const KEY& hi) const {
+    if (!_comp(lo, hi)) {
+      return 0;
+    }
+    return rank(hi) - rank(lo);
+  }
+
+  const_iterator lower_bound(const KEY& key) const {
+    return select(rank(key));
+  }
+
+  /**
+   * @brief Erase the key, O(log n).
+   *
+   * @return size_t The erased number, zero or one.
+   */
+  size_t erase(const KEY& key) {
+    if (!_root) {
+      return 0;
+    }
+    Path path;
+    Node* leaf = descend(key, &path);
+    size_t index = itemIndex(*leaf, key);
+    if (index == leaf->items.size() ||
+        _comp(key, KEY_OF()(leaf->items[index]))) {
+      return 0;
+    }
+    leaf->items.erase(leaf->items.begin() + index);
+    for (auto& [node, i] : path) {
+      --node->counts[i];
+    }
+    --_size;
+    rebalance(leaf, &path);
+    return 1;
+  }
+
+ protected:
+  /**
+   * @brief Insert the item constructed from args if the key is not existed.
+   *
+   * @return std::pair<ITEM*, bool> The item of the key, valid until the tree
+   * is modified, and whether it is inserted.
+   */
+  template <class... ARGS>
+  std::pair<ITEM*, bool> emplaceUnique(const KEY& key, ARGS&&... args) {
+    if (!_root) {
+      _root = std::make_unique<Node>(true);
+    }
+    Path path;
+    Node* leaf = descend(key, &path);
+    size_t index = itemIndex(*leaf, key);
+    if (index < leaf->items.size() &&
+        !_comp(key, KEY_OF()(leaf->items[index]))) {
+      return {&leaf->items[index], false};
+    }
+    leaf->items.emplace(leaf->items.begin() + index,
+                        std::forward<ARGS>(args)...);
+    for (auto& [node, i] : path) {
+      ++node->counts[i];
+    }
+    ++_size;
+    if (leaf->items.size() <= kNodeSize) {
+      return {&leaf->items[index], true};
+    }
+    Node* right = split(leaf, &path);
+    return index < leaf->items.size()
+               ? std::make_pair(&leaf->items[index], true)
+               : std::make_pair(&right->items[index - leaf->items.size()],
+                                true);
+  }
+
+ private:
+  size_t childIndex(const Node& node, const KEY& key) const {
+    return std::upper_bound(node.keys.begin(), node.keys.end(), key, _comp) -
+           node.keys.begin();
+  }
+  size_t itemIndex(const Node& leaf, const KEY& key) const {
+    return std::lower_bound(leaf.items.begin(), leaf.items.end(), key,
+                            [this](const ITEM& item, const KEY& k) {
+                              return _comp(KEY_OF()(item), k);
+                            }) -
+           leaf.items.begin();
+  }
+
+  Node* descend(const KEY& key, Path* path) {
+    Node* node = _root.get();
+    while (!node->leaf) {
+      size_t i = childIndex(*node, key);
+      path->emplace_back(node, i);
+      node = node->children[i].get();
+    }
+    return node;
+  }
+
+  static size_t itemCount(const Node& node) {
+    if (node.leaf) {
+      return node.items.size();
+    }
+    size_t count = 0;
+    for (size_t c : node.counts) {
+      count += c;
+    }
+    return count;
+  }
+
+  // Split the full node into two halves, the right half is added to the
+  // parent, which is split too when it becomes full.Return the right half.
+  Node* split(Node* node, Path* path) {
+    auto right = std::make_unique<Node>(node->leaf);
+    KEY separator = node->leaf ? splitLeaf(node, right.get())
+                               : splitInternal(node, right.get());
+    Node* right_node = right.get();
+    if (path->empty()) {
+      auto root = std::make_unique<Node>(false);
+      root->keys.push_back(std::move(separator));
+      root->counts = {itemCount(*node), itemCount(*right)};
+      root->children.push_back(std::move(_root));
+      root->children.push_back(std::move(right));
+      _root = std::move(root);
+      return right_node;
+    }
+    auto [parent, i] = path->back();
+    path->pop_back();
+    parent->counts[i] = itemCount(*node);
+    parent->counts.insert(parent->counts.begin() + i + 1, itemCount(*right));
+    parent->keys.insert(parent->keys.begin() + i, std::move(separator));
+    parent->children.insert(parent->children.begin() + i + 1,
+                            std::move(right));
+    if (parent->size() > kNodeSize) {
+      split(parent, path);
+    }
+    return right_node;
+  }
+
+  // Move the upper half of the leaf to right, return the separator.
+  static KEY splitLeaf(Node* node, Node* right) {
+    size_t half = node->items.size() / 2;
+    right->items.assign(std::make_move_iterator(node->items.begin() + half),
+                        std::make_move_iterator(node->items.end()));
+    node->items.resize(half);
+    right->next = node->next;
+    node->next = right;
+    return KEY_OF()(right->items.front());
+  }
+
+  // Move the upper half of the internal node to right, the middle separator
+  // goes up to the parent.
+  static KEY splitInternal(Node* node, Node* right) {
+    size_t half = node->children.size() / 2;
+    KEY separator = std::move(node->keys[half - 1]);
+    right->keys.assign(std::make_move_iterator(node->keys.begin() + half),
+                       std::make_move_iterator(node->keys.end()));
+    node->keys.resize(half - 1);
+    right->children.assign(
+        std::make_move_iterator(node->children.begin() + half),
+        std::make_move_iterator(node->children.end()));
+    node->children.resize(half);
+    right->counts.assign(node->counts.begin() + half, node->counts.end());
+    node->counts.resize(half);
+    return separator;
+  }
+
+  // Merge the node less than half full with the sibling if they fit in one
+  // node, up to the root, or else move the items from the sibling.
+  void rebalance(Node* node, Path* path) {
+    while (!path->empty() && node->size() < kNodeSize / 2) {
+      auto [parent, i] = path->back();
+      path->pop_back();
+      size_t left = i + 1 < parent->children.size() ? i : i - 1;
+      if (parent->children[left]->size() +
+              parent->children[left + 1]->size() >
+          kNodeSize) {
+        // The sibling is more than half full, so both are at least half full
+        // after the move.
+        redistribute(parent, left);
+        break;
+      }
+      merge(parent, left);
+      node = parent;
+    }
+    while (!_root->leaf && _root->children.size() == 1) {
+      _root = std::move(_root->children.front());
+    }
+    if (_root->leaf && _root->items.empty()) {
+      _root.reset();
+    }
+  }
+
+  // Move the items or children between the child left and left + 1 of the
+  // parent so that they have the same size.
+  void redistribute(Node* parent, size_t left) {
+    Node* dst = parent->children[left].get();
+    Node* src = parent->children[left + 1].get();
+    size_t total = dst->size() + src->size();
+    if (dst->leaf) {
+      if (dst->items.size() < src->items.size()) {
+        size_t num = src->items.size() - total / 2;
+        std::move(src->items.begin(), src->items.begin() + num,
+                  std::back_inserter(dst->items));
+        src->items.erase(src->items.begin(), src->items.begin() + num);
+        parent->counts[left] += num;
+        parent->counts[left + 1] -= num;
+      } else {
+        size_t num = dst->items.size() - total / 2;
+        src->items.insert(src->items.begin(),
+                          std::make_move_iterator(dst->items.end() - num),
+                          std::make_move_iterator(dst->items.end()));
+        dst->items.resize(dst->items.size() - num);
+        parent->counts[left] -= num;
+        parent->counts[left + 1] += num;
+      }
+      parent->keys[left] = KEY_OF()(src->items.front());
+      return;
+    }
+    if (dst->children.size() < src->children.size()) {
+      // The separator goes down to dst and the key between the moved
+      // children and the rest of src goes up.
+      size_t num = src->children.size() - total / 2;
+      dst->keys.push_back(std::move(parent->keys[left]));
+      std::move(src->keys.begin(), src->keys.begin() + num - 1,
+                std::back_inserter(dst->keys));
+      parent->keys[left] = std::move(src->keys[num - 1]);
+      src->keys.erase(src->keys.begin(), src->keys.begin() + num);
+      std::move(src->children.begin(), src->children.begin() + num,
+                std::back_inserter(dst->children));
+      src->children.erase(src->children.begin(),
+                          src->children.begin() + num);
+      size_t moved_count = 0;
+      for (size_t j = 0; j < num; ++j) {
+        moved_count += src->counts[j];
+      }
+      dst->counts.insert(dst->counts.end(), src->counts.begin(),
+                         src->counts.begin() + num);
+      src->counts.erase(src->counts.begin(), src->counts.begin() + num);
+      parent->counts[left] += moved_count;
+      parent->counts[left + 1] -= moved_count;
+    } else {
+      size_t num = dst->children.size() - total / 2;
+      size_t first = dst->children.size() - num;
+      std::vector<KEY> keys;
+      keys.reserve(src->keys.size() + num);
+      std::move(dst->keys.begin() + first, dst->keys.end(),
+                std::back_inserter(keys));
+      keys.push_back(std::move(parent->keys[left]));
+      std::move(src->keys.begin(), src->keys.end(), std::back_inserter(keys));
+      src->keys = std::move(keys);
+      parent->keys[left] = std::move(dst->keys[first - 1]);
+      dst->keys.resize(first - 1);
+      src->children.insert(
+          src->children.begin(),
+          std::make_move_iterator(dst->children.begin() + first),
+          std::make_move_iterator(dst->children.end()));
+      dst->children.resize(first);
+      size_t moved_count = 0;
+      for (size_t j = first; j < dst->counts.size(); ++j) {
+        moved_count += dst->counts[j];
+      }
+      src->counts.insert(src->counts.begin(), dst->counts.begin() + first,
+                         dst->counts.end());
+      dst->counts.resize(first);
+      parent->counts[left] -= moved_count;
+      parent->counts[left + 1] += moved_count;
+    }
+  }
+
+  // Merge the child left + 1 of the parent into the child left.
+  void merge(Node* parent, size_t left) {
+    Node* dst = parent->children[left].get();
+    Node* src = parent->children[left + 1].get();
+    if (dst->leaf) {
+      std::move(src->items.begin(), src->items.end(),
+                std::back_inserter(dst->items));
+      dst->next = src->next;
+    } else {
+      dst->keys.push_back(std::move(parent->keys[left]));
+      std::move(src->keys.begin(), src->keys.end(),
+                std::back_inserter(dst->keys));
+      std::move(src->children.begin(), src->children.end(),
+                std::back_inserter(dst->children));
+      dst->counts.insert(dst->counts.end(), src->counts.begin(),
+                         src->counts.end());
+    }
+    parent->counts[left] += parent->counts[left + 1];
+    parent->counts.erase(parent->counts.begin() + left + 1);
+    parent->keys.erase(parent->keys.begin() + left);
+    parent->children.erase(parent->children.begin() + left + 1);
+  }
+
+  // Copy the subtree, the copied leaves are linked after prev_leaf.
+  static std::unique_ptr<Node> clone(const Node& node, Node** prev_leaf) {
+    auto copy = std::make_unique<Node>(node.leaf);
+    if (node.leaf) {
+      copy->items = node.items;
+      if (*prev_leaf) {
+        (*prev_leaf)->next = copy.get();
+      }
+      *prev_leaf = copy.get();
+      return copy;
+    }
+    copy->keys = node.keys;
+    copy->counts = node.counts;
+    for (const auto& child : node.children) {
+      copy->children.push_back(clone(*child, prev_leaf));
+    }
+    return copy;
+  }
+
+  std::unique_ptr<Node> _root;
+  CMP _comp;
+  size_t _size = 0;
+};
+
+}  // namespace detail
+
+/**
+ * @brief The ordered set answering the rank queries in O(log n), such as the
+ * top k or the percentile of the slacks.
+ *
+ * OrderStatisticSet<double> slacks;
+ * ...
+ * double worst_1000 = *slacks.select(999);
+ * size_t num_violated = slacks.rank(0.0);
+ *
+ * @tparam KEY
+ * @tparam CMP
+ */
+template <class KEY, class CMP = std::less<KEY>>
+class OrderStatisticSet
+    : public detail::OrderStatisticTree<KEY, KEY, detail::IdentityKey, CMP> {
+ public:
+  using Base = detail::OrderStatisticTree<KEY, KEY, detail::IdentityKey, CMP>;
+  using Base::Base;
+
+  OrderStatisticSet() = default;
+  OrderStatisticSet(std::initializer_list<KEY> keys) {
+    for (const KEY& key : keys) {
+      insert(key);
+    }
+  }
+
+  /**
+   * @brief Insert the key, O(log n).
+   *
+   * @return true if inserted.
+   * @return false if the key is existed.
+   */
+  bool insert(const KEY& key) { return this->emplaceUnique(key, key).second; }
+  template <class ITER>
+  void insert(ITER first, ITER last) {
+    for (; first != last; ++first) {
+      insert(*first);
+    }
+  }
+};
+
+/**
+ * @brief The ordered map answering the rank queries in O(log n) as the
+ * OrderStatisticSet.
+ *
+ * @tparam KEY
+ * @tparam VALUE
+ * @tparam CMP
+ */
+template <class KEY, class VALUE, class CMP = std::less<KEY>>
+class OrderStatisticMap
+    : public detail::OrderStatisticTree<KEY, std::pair<KEY, VALUE>,
+                                        detail::PairFirstKey, CMP> {
+ public:
+  using Base = detail::OrderStatisticTree<KEY, std::pair<KEY, VALUE>,
+                                          detail::PairFirstKey, CMP>;
+  using mapped_type = VALUE;
+  using Base::Base;
+
+  /**
+   * @brief Insert the (key, value) to the map, or assign the value if the key
+   * is existed, O(log n).
+   */
+  template <class V>
+  void insert(const KEY& key, V&& value) {
+    auto result = this->emplaceUnique(key, key, std::forward<V>(value));
+    if (!result.second) {
+      result.first->second = std::forward<V>(value);
+    }
+  }
+
+  VALUE& operator[](const KEY& key) {
+    return this->emplaceUnique(key, key, VALUE()).first->second;
+  }
+
+  /**
+   * @brief Find the value corresponding to key.
+   *
+   * @param key The key to be found.
+   * @param default_value the default return value if not found.
+   * @return const VALUE return the found value.
+   */
+  const VALUE value(const KEY& key,
+                    const VALUE& default_value = VALUE()) const {
+    auto iter = this->find(key);
+    return iter != this->end() ? iter->second : default_value;
+  }
+};
+
+}  // namespace pcl
@@ -0,0 +1,75 @@
+/**
+ * @file Parallel.h
+ * @author simin tao (taosm@pcl.ac.cn)
+ * @brief The parallel loop utility for the eda project.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace pcl {
+
+/**
+ * @brief Get the default thread number, that is the hardware concurrency.
+ *
+ * @return int The thread number, at least one.
+ */
+inline int defaultThreadNum() {
+  unsigned num = std::thread::hardware_concurrency();
+  return num == 0 ? 1 : static_cast<int>(num);
+}
+
+/**
+ * @brief Split the index range [0, n) into contiguous chunks and run the
+ * func(thread_id, begin, end) on each chunk.
+ *
+ * The calling thread runs the first chunk itself, so num_threads == 1 runs
+ * without creating any thread.The chunk boundary only depends on n and
+ * num_threads.
+ *
+ * @tparam FUNC The callable type of void(int, size_t, size_t).
+ * @param n The index range size.
+ * @param num_threads The thread number, zero or negative means the hardware
+ * concurrency.
+ * @param func The chunk function.
+ */
+template <typename FUNC>
+void parallelFor(size_t n, int num_threads, FUNC&& func) {
+  if (num_threads <= 0) {
+    num_threads = defaultThreadNum();
+  }
+  size_t chunk_num = std::min(static_cast<size_t>(num_threads), n);
+  if (chunk_num <= 1) {
+    func(0, static_cast<size_t>(0), n);
+    return;
+  }
+
+  size_t chunk_size = n / chunk_num;
+  size_t remain = n % chunk_num;
+  auto chunk_begin = [chunk_size, remain](size_t i) {
+    return i * chunk_size + std::min(i, remain);
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(chunk_num - 1);
+  for (size_t i = 1; i < chunk_num; ++i) {
+    threads.emplace_back([&func, &chunk_begin, i]() {
+      func(static_cast<int>(i), chunk_begin(i), chunk_begin(i + 1));
+    });
+  }
+  func(0, chunk_begin(0), chunk_begin(1));
+  for (auto& t : threads) {
+    t.join();
+  }
+}
+
+}  // namespace pcl
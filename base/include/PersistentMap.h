@@ -0,0 +1,575 @@
+/**
+ * @file PersistentMap.h
+ * @author simin tao (taosm@pcl.ac.cn)
+ * @brief The persistent copy on write map and set for the eda project.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "KeyOf.h"
+
+namespace pcl {
+
+namespace detail {
+
+/**
+ * @brief The B+ tree sharing the nodes between the copies.
+ *
+ * The nodes are held by std::shared_ptr, so the copy of the tree only copies
+ * the root pointer.The modification copies the nodes on the path from the
+ * root to the leaf which are shared with other copies, and modifies the node
+ * owned only by this tree in place, so it copies O(log n) nodes at most.The
+ * node reachable from a copy is never modified, and the reference count is
+ * atomic, so the copy can be read by other threads while this tree is
+ * modified.The node is only modified in place after an acquire fence on its
+ * reference count of one, so the reads of the copy released by another
+ * thread happen before the modification.
+ *
+ * @tparam KEY
+ * @tparam ITEM The stored item, KEY or the (KEY, VALUE) pair.
+ * @tparam KEY_OF The callable type of const KEY&(const ITEM&).
+ * @tparam CMP
+ */
+template <class KEY, class ITEM, class KEY_OF, class CMP>
+class PersistentTree {
+ public:
+  using key_type = KEY;
+  using value_type = ITEM;
+  using key_compare = CMP;
+  using size_type = size_t;
+
+  // The max item number of the leaf and the max child number of the internal
+  // node.
+  static constexpr size_t kNodeSize = 32;
+
+ private:
+  struct Node {
+    explicit Node(bool is_leaf) : leaf(is_leaf) {}
+    bool leaf;
+    std::vector<ITEM> items;  // The leaf items.
+    // The separator j is not greater than the keys of the child j + 1 and
+    // greater than the keys of the child j.
+    std::vector<KEY> keys;
+    std::vector<std::shared_ptr<Node>> children;
+
+    size_t size() const { return leaf ? items.size() : children.size(); }
+  };
+  using NodePtr = std::shared_ptr<Node>;
+  // The separator and the new right node of the split.
+  using Split = std::optional<std::pair<KEY, NodePtr>>;
+
+ public:
+  /**
+   * @brief The forward iterator in the key order, it is valid as long as the
+   * tree or a copy of it is not destroyed.
+   */
+  class const_iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = ITEM;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const ITEM*;
+    using reference = const ITEM&;
+
+    const_iterator() = default;
+
+    reference operator*() const {
+      return _path.back().first->items[_path.back().second];
+    }
+    pointer operator->() const { return &**this; }
+    const_iterator& operator++() {
+      if (++_path.back().second < _path.back().first->items.size()) {
+        return *this;
+      }
+      _path.pop_back();
+      while (!_path.empty()) {
+        auto& [node, i] = _path.back();
+        if (++i < node->children.size()) {
+          descendLeftmost(node->children[i].get());
+          break;
+        }
+        _path.pop_back();
+      }
+      return *this;
+    }
+    const_iterator operator++(int) {
+      const_iterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+    bool operator==(const const_iterator& o) const {
+      if (_path.empty() || o._path.empty()) {
+        return _path.empty() == o._path.empty();
+      }
+      return _path.back() == o._path.back();
+    }
+    bool operator!=(const const_iterator& o) const { return !(*this == o); }
+
+   private:
+    friend class PersistentTree;
+
+    void descendLeftmost(const Node* node) {
+      while (!node->leaf) {
+        _path.emplace_back(node, 0);
+        node = node->children.front().get();
+      }
+      _path.emplace_back(node, 0);
+    }
+
+    // The nodes and the child or item index from the root.
+    std::vector<std::pair<const Node*, size_t>> _path;
+  };
+  using iterator = const_iterator;
+
+  PersistentTree() = default;
+  explicit PersistentTree(const CMP& comp) : _comp(comp) {}
+  ~PersistentTree() = default;
+  // The copy is O(1), the nodes are shared.
+  PersistentTree(const PersistentTree&) = default;
+  PersistentTree(PersistentTree&& other) noexcept
+      : _root(std::move(other._root)),
+        _comp(std::move(other._comp)),
+        _size(other._size) {
+    other._size = 0;
+  }
+  PersistentTree& operator=(const PersistentTree&) = default;
+  PersistentTree& operator=(PersistentTree&& other) noexcept {
+    if (this != &other) {
+      _root = std::move(other._root);
+      _comp = std::move(other._comp);
+      _size = other._size;
+      other._size = 0;
+    }
+    return *this;
+  }
+
+  const_iterator begin() const {
+    const_iterator iter;
+    if (_root) {
+      iter.descendLeftmost(_root.get());
+    }
+    return iter;
+  }
+  const_iterator end() const { return const_iterator(); }
+
+  size_t size() const { return _size; }
+  bool empty() const { return _size == 0; }
+  void clear() {
+    _root.reset();
+    _size = 0;
+  }
+  void swap(PersistentTree& other) {
+    std::swap(_root, other._root);
+    std::swap(_comp, other._comp);
+    std::swap(_size, other._size);
+  }
+  key_compare key_comp() const { return _comp; }
+
+  const_iterator find(const KEY& key) const {
+    const_iterator iter;
+    const Node* node = _root.get();
+    if (node == nullptr) {
+      return iter;
+    }
+    while (!node->leaf) {
+      size_t i = childIndex(*node, key);
+      iter._path.emplace_back(node, i);
+      node = node->children[i].get();
+    }
+    size_t index = itemIndex(*node, key);
+    if (index < node->items.size() &&
+        !_comp(key, KEY_OF()(node->items[index]))) {
+      iter._path.emplace_back(node, index);
+      return iter;
+    }
+    return end();
+  }
+  bool contains(const KEY& key) const { return find(key) != end(); }
+  bool hasKey(const KEY& key) const { return contains(key); }
+  size_t count(const KEY& key) const { return contains(key) ? 1 : 0; }
+
+  /**
+   * @brief Erase the key, the shared nodes on the path are copied.
+   *
+   * @return size_t The erased number, zero or one.
+   */
+  size_t erase(const KEY& key) {
+    if (!contains(key)) {
+      return 0;
+    }
+    eraseFrom(&_root, key);
+    --_size;
+    while (!_root->leaf && _root->children.size() == 1) {
+      _root = _root->children.front();
+    }
+    if (_root->leaf && _root->items.empty()) {
+      _root.reset();
+    }
+    return 1;
+  }
+
+  /**
+   * @brief Whether the two trees share the root, that is one is the unmodified
+   * copy of the other.
+   */
+  bool sharesWith(const PersistentTree& other) const {
+    return _root == other._root;
+  }
+
+ protected:
+  /**
+   * @brief Insert the item if the key is not existed, or assign the item if
+   * assign is true.
+   *
+   * @return true if inserted.
+   */
+  bool insertItem(const KEY& key, ITEM item, bool assign) {
+    if (!_root) {
+      _root = std::make_shared<Node>(true);
+    }
+    bool inserted = false;
+    Split split = insertInto(&_root, key, &item, assign, &inserted);
+    if (split) {
+      auto root = std::make_shared<Node>(false);
+      root->keys.push_back(std::move(split->first));
+      root->children.push_back(std::move(_root));
+      root->children.push_back(std::move(split->second));
+      _root = std::move(root);
+    }
+    _size += inserted;
+    return inserted;
+  }
+
+  /**
+   * @brief Get the item of the key for the modification, the shared nodes on
+   * the path are copied.
+   *
+   * @return ITEM* The item, nullptr if not found.
+   */
+  ITEM* mutableItem(const KEY& key) {
+    if (!contains(key)) {
+      return nullptr;
+    }
+    Node* node = mutableNode(&_root);
+    while (!node->leaf) {
+      node = mutableNode(&node->children[childIndex(*node, key)]);
+    }
+    return &node->items[itemIndex(*node, key)];
+  }
+
+ private:
+  size_t childIndex(const Node& node, const KEY& key) const {
+    return std::upper_bound(node.keys.begin(), node.keys.end(), key, _comp) -
+           node.keys.begin();
+  }
+  size_t itemIndex(const Node& leaf, const KEY& key) const {
+    return std::lower_bound(leaf.items.begin(), leaf.items.end(), key,
+                            [this](const ITEM& item, const KEY& k) {
+                              return _comp(KEY_OF()(item), k);
+                            }) -
+           leaf.items.begin();
+  }
+
+  // Copy the node if it is shared with other trees, the node held by this
+  // tree only is modified in place.use_count is a relaxed load, the fence
+  // pairs with the release decrement of the last other reference.
+  static Node* mutableNode(NodePtr* ptr) {
+    if (ptr->use_count() != 1) {
+      *ptr = std::make_shared<Node>(**ptr);
+    } else {
+      std::atomic_thread_fence(std::memory_order_acquire);
+    }
+    return ptr->get();
+  }
+
+  Split insertInto(NodePtr* ptr, const KEY& key, ITEM* item, bool assign,
+                   bool* inserted) {
+    Node* node = mutableNode(ptr);
+    if (node->leaf) {
+      size_t index = itemIndex(*node, key);
+      if (index < node->items.size() &&
+          !_comp(key, KEY_OF()(node->items[index]))) {
+        if (assign) {
+          node->items[index] = std::move(*item);
+        }
+        return std::nullopt;
+      }
+      node->items.insert(node->items.begin() + index, std::move(*item));
+      *inserted = true;
+    } else {
+      size_t i = childIndex(*node, key);
+      Split split = insertInto(&node->children[i], key, item, assign, inserted);
+      if (!split) {
+        return std::nullopt;
+      }
+      node->keys.insert(node->keys.begin() + i, std::move(split->first));
+      node->children.insert(node->children.begin() + i + 1,
+                            std::move(split->second));
+    }
+    if (node->size() <= kNodeSize) {
+      return std::nullopt;
+    }
+    return splitNode(node);
+  }
+
+  // Move the upper half of the full node to the new right node.
+  static Split splitNode(Node* node) {
+    auto right = std::make_shared<Node>(node->leaf);
+    size_t half = node->size() / 2;
+    if (node->leaf) {
+      right->items.assign(std::make_move_iterator(node->items.begin() + half),
+                          std::make_move_iterator(node->items.end()));
+      node->items.resize(half);
+      KEY separator = KEY_OF()(right->items.front());
+      return std::make_pair(std::move(separator), std::move(right));
+    }
+    KEY separator = std::move(node->keys[half - 1]);
+    right->keys.assign(std::make_move_iterator(node->keys.begin() + half),
+                       std::make_move_iterator(node->keys.end()));
+    node->keys.resize(half - 1);
+    right->children.assign(
+        std::make_move_iterator(node->children.begin() + half),
+        std::make_move_iterator(node->children.end()));
+    node->children.resize(half);
+    return std::make_pair(std::move(separator), std::move(right));
+  }
+
+  // Erase the existed key from the subtree, the child less than half full is
+  // merged with the sibling if they fit in one node, or else it takes the
+  // items from the sibling, so each node but the root is at least half full.
+  void eraseFrom(NodePtr* ptr, const KEY& key) {
+    Node* node = mutableNode(ptr);
+    if (node->leaf) {
+      node->items.erase(node->items.begin() + itemIndex(*node, key));
+      return;
+    }
+    size_t i = childIndex(*node, key);
+    eraseFrom(&node->children[i], key);
+    if (node->children[i]->size() >= kNodeSize / 2) {
+      return;
+    }
+    size_t left = i + 1 < node->children.size() ? i : i - 1;
+    if (node->children[left]->size() + node->children[left + 1]->size() <=
+        kNodeSize) {
+      mergeChildren(node, left);
+    } else {
+      redistributeChildren(node, left);
+    }
+  }
+
+  // Merge the child left + 1 into the child left, the right child may be
+  // shared, so it is copied from.
+  static void mergeChildren(Node* node, size_t left) {
+    Node* dst = mutableNode(&node->children[left]);
+    const Node* src = node->children[left + 1].get();
+    if (dst->leaf) {
+      dst->items.insert(dst->items.end(), src->items.begin(),
+                        src->items.end());
+    } else {
+      dst->keys.push_back(node->keys[left]);
+      dst->keys.insert(dst->keys.end(), src->keys.begin(), src->keys.end());
+      dst->children.insert(dst->children.end(), src->children.begin(),
+                           src->children.end());
+    }
+    node->keys.erase(node->keys.begin() + left);
+    node->children.erase(node->children.begin() + left + 1);
+  }
+
+  // Move the items or children between the child left and left + 1 so that
+  // they have the same size, both children are copied if shared.
+  static void redistributeChildren(Node* node, size_t left) {
+    Node* dst = mutableNode(&node->children[left]);
+    Node* src = mutableNode(&node->children[left + 1]);
+    size_t total = dst->size() + src->size();
+    if (dst->leaf) {
+      if (dst->items.size() < src->items.size()) {
+        size_t num = src->items.size() - total / 2;
+        std::move(src->items.begin(), src->items.begin() + num,
+                  std::back_inserter(dst->items));
+        src->items.erase(src->items.begin(), src->items.begin() + num);
+      } else {
+        size_t num = dst->items.size() - total / 2;
+        src->items.insert(src->items.begin(),
+                          std::make_move_iterator(dst->items.end() - num),
+                          std::make_move_iterator(dst->items.end()));
+        dst->items.resize(dst->items.size() - num);
+      }
+      node->keys[left] = KEY_OF()(src->items.front());
+      return;
+    }
+    if (dst->children.size() < src->children.size()) {
+      // The separator goes down to dst and the key between the moved
+      // children and the rest of src goes up.
+      size_t num = src->children.size() - total / 2;
+      dst->keys.push_back(std::move(node->keys[left]));
+      std::move(src->keys.begin(), src->keys.begin() + num - 1,
+                std::back_inserter(dst->keys));
+      node->keys[left] = std::move(src->keys[num - 1]);
+      src->keys.erase(src->keys.begin(), src->keys.begin() + num);
+      std::move(src->children.begin(), src->children.begin() + num,
+                std::back_inserter(dst->children));
+      src->children.erase(src->children.begin(),
+                          src->children.begin() + num);
+      return;
+    }
+    size_t num = dst->children.size() - total / 2;
+    size_t first = dst->children.size() - num;
+    std::vector<KEY> keys;
+    keys.reserve(src->keys.size() + num);
+    std::move(dst->keys.begin() + first, dst->keys.end(),
+              std::back_inserter(keys));
+    keys.push_back(std::move(node->keys[left]));
+    std::move(src->keys.begin(), src->keys.end(), std::back_inserter(keys));
+    src->keys = std::move(keys);
+    node->keys[left] = std::move(dst->keys[first - 1]);
+    dst->keys.resize(first - 1);
+    src->children.insert(
+        src->children.begin(),
+        std::make_move_iterator(dst->children.begin() + first),
+        std::make_move_iterator(dst->children.end()));
+    dst->children.resize(first);
+  }
+
+  NodePtr _root;
+  CMP _comp;
+  size_t _size = 0;
+};
+
+}  // namespace detail
+
+/**
+ * @brief The persistent ordered map for the cheap what if snapshots.
+ *
+ * The snapshot is O(1) and shares all nodes with the map, the later
+ * modification of the map copies only the O(log n) nodes on its path, so the
+ * baseline of the ECO what if analysis costs nearly nothing.The snapshot is
+ * immutable, so it can be read by other threads without lock while the map
+ * is modified.The snapshot must be taken by the thread modifying the map.
+ *
+ * PersistentMap<std::string, double> arrivals;
+ * ...
+ * auto baseline = arrivals.snapshot();
+ * arrivals.insert("u1/Z", 1.2);  // The baseline is unchanged.
+ *
+ * @tparam KEY
+ * @tparam VALUE
+ * @tparam CMP
+ */
+template <class KEY, class VALUE, class CMP = std::less<KEY>>
+class PersistentMap
+    : public detail::PersistentTree<KEY, std::pair<KEY, VALUE>,
+                                    detail::PairFirstKey, CMP> {
+ public:
+  using Base = detail::PersistentTree<KEY, std::pair<KEY, VALUE>,
+                                      detail::PairFirstKey, CMP>;
+  using mapped_type = VALUE;
+  using Base::Base;
+
+  PersistentMap() = default;
+  PersistentMap(std::initializer_list<std::pair<KEY, VALUE>> items) {
+    for (const auto& item : items) {
+      insert(item.first, item.second);
+    }
+  }
+
+  /**
+   * @brief The O(1) snapshot sharing all nodes with the map.
+   */
+  PersistentMap snapshot() const { return *this; }
+
+  /**
+   * @brief Insert the (key, value) to the map, or assign the value if the key
+   * is existed.
+   */
+  void insert(const KEY& key, VALUE value) {
+    this->insertItem(key, std::make_pair(key, std::move(value)), true);
+  }
+
+  /**
+   * @brief Find the value corresponding to key.
+   *
+   * @param key The key to be found.
+   * @param default_value the default return value if not found.
+   * @return const VALUE return the found value.
+   */
+  const VALUE value(const KEY& key,
+                    const VALUE& default_value = VALUE()) const {
+    auto iter = this->find(key);
+    return iter != this->end() ? iter->second : default_value;
+  }
+
+  /**
+   * @brief Modify the value of the key in place by func(VALUE&), the shared
+   * nodes on the path are copied.
+   *
+   * @return true if the key is found.
+   */
+  template <typename FUNC>
+  bool update(const KEY& key, FUNC&& func) {
+    auto* item = this->mutableItem(key);
+    if (item == nullptr) {
+      return false;
+    }
+    func(item->second);
+    return true;
+  }
+};
+
+/**
+ * @brief The persistent ordered set, see PersistentMap.
+ *
+ * @tparam KEY
+ * @tparam CMP
+ */
+template <class KEY, class CMP = std::less<KEY>>
+class PersistentSet
+    : public detail::PersistentTree<KEY, KEY, detail::IdentityKey,
+                                    CMP> {
+ public:
+  using Base = detail::PersistentTree<KEY, KEY, detail::IdentityKey,
+                                      CMP>;
+  using Base::Base;
+
+  PersistentSet() = default;
+  PersistentSet(std::initializer_list<KEY> keys) {
+    for (const KEY& key : keys) {
+      insert(key);
+    }
+  }
+
+  /**
+   * @brief The O(1) snapshot sharing all nodes with the set.
+   */
+  PersistentSet snapshot() const { return *this; }
+
+  /**
+   * @brief Insert the key.
+   *
+   * @return true if inserted.
+   * @return false if the key is existed, nothing is copied.
+   */
+  bool insert(const KEY& key) {
+    if (this->contains(key)) {
+      return false;
+    }
+    return this->insertItem(key, key, false);
+  }
+};
+
+}  // namespace pcl
@@ -0,0 +1,136 @@
+/**
+ * @file RangeView.h
+ * @author simin tao (taosm@pcl.ac.cn)
+ * @brief The lazy iterator range views of the containers for the eda project.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace pcl {
+
+/**
+ * @brief The iterator adaptor of the map iterator which yields the key or the
+ * value of the pair in place, nothing is copied.
+ *
+ * @tparam ITER The map iterator.
+ * @tparam SECOND Whether yields the value(second) instead of the key(first).
+ */
+template <class ITER, bool SECOND>
+class PairMemberIterator {
+ public:
+  using pair_reference = typename std::iterator_traits<ITER>::reference;
+  using reference = typename std::conditional<
+      SECOND, decltype((std::declval<pair_reference>().second)),
+      decltype((std::declval<pair_reference>().first))>::type;
+  using value_type = typename std::remove_cv<
+      typename std::remove_reference<reference>::type>::type;
+  using pointer = typename std::add_pointer<reference>::type;
+  using difference_type = typename std::iterator_traits<ITER>::difference_type;
+  using iterator_category = std::forward_iterator_tag;
+
+  PairMemberIterator() = default;
+  explicit PairMemberIterator(ITER iter) : _iter(iter) {}
+
+  reference operator*() const {
+    if constexpr (SECOND) {
+      return _iter->second;
+    } else {
+      return _iter->first;
+    }
+  }
+  pointer operator->() const { return &**this; }
+
+  PairMemberIterator& operator++() {
+    ++_iter;
+    return *this;
+  }
+  PairMemberIterator operator++(int) {
+    PairMemberIterator tmp = *this;
+    ++_iter;
+    return tmp;
+  }
+
+  bool operator==(const PairMemberIterator& o) const {
+    return _iter == o._iter;
+  }
+  bool operator!=(const PairMemberIterator& o) const {
+    return _iter != o._iter;
+  }
+
+  ITER base() const { return _iter; }
+
+ private:
+  ITER _iter;
+};
+
+/**
+ * @brief The lazy view of the [begin, end) iterator range, it is valid as long
+ * as the container is not modified.
+ *
+ * for (const auto& key : hmap.keysView()) {
+ *   ...
+ * }
+ *
+ * @tparam ITER The iterator.
+ */
+template <class ITER>
+class IteratorRange {
+ public:
+  using iterator = ITER;
+  using const_iterator = ITER;
+  using value_type = typename std::iterator_traits<ITER>::value_type;
+
+  IteratorRange(ITER begin, ITER end, size_t size)
+      : _begin(begin), _end(end), _size(size) {}
+
+  ITER begin() const { return _begin; }
+  ITER end() const { return _end; }
+  size_t size() const { return _size; }
+  bool empty() const { return _size == 0; }
+
+ private:
+  ITER _begin;
+  ITER _end;
+  size_t _size;
+};
+
+template <class ITER>
+using KeyIterator = PairMemberIterator<ITER, false>;
+
+template <class ITER>
+using ValueIterator = PairMemberIterator<ITER, true>;
+
+/**
+ * @brief Make the key view of the map.
+ */
+template <class MAP>
+IteratorRange<KeyIterator<typename MAP::const_iterator>> makeKeysView(
+    const MAP& map) {
+  using Iter = KeyIterator<typename MAP::const_iterator>;
+  return {Iter(map.begin()), Iter(map.end()),
+          static_cast<size_t>(map.size())};
+}
+
+/**
+ * @brief Make the value view of the map, the value can be modified through
+ * the view of the non const map.
+ */
+template <class MAP>
+auto makeValuesView(MAP& map)
+    -> IteratorRange<ValueIterator<decltype(map.begin())>> {
+  using Iter = ValueIterator<decltype(map.begin())>;
+  return {Iter(map.begin()), Iter(map.end()),
+          static_cast<size_t>(map.size())};
+}
+
+}  // namespace pcl
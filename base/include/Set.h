@@ -11,9 +11,13 @@
 
 #pragma once
 
+#include <algorithm>
 #include <functional>
+#include <queue>
 #include <utility>
+#include <vector>
 
+#include "Parallel.h"
 #include "absl/container/btree_set.h"
 
 namespace pcl {
@@ -36,6 +40,13 @@ class Set : public absl::btree_set<KEY, CMP> {
   using const_iterator = typename Base::const_iterator;
   using reverse_iterator = typename Base::reverse_iterator;
   using const_reverse_iterator = typename Base::const_reverse_iterator;
+  // The key type of heterogeneous lookup, it is K when the comparator is
+  // transparent, otherwise KEY.The protected key_arg of the btree container is
+  // not reused, gcc recurses infinitely substituting it in a derived class.
+  template <class K>
+  using key_arg = typename absl::container_internal::KeyArg<
+      absl::container_internal::IsTransparent<
+          typename Base::key_compare>::value>::template type<K, KEY>;
 
   /*constructor*/
   using Base::Base;
@@ -81,27 +92,78 @@ class Set : public absl::btree_set<KEY, CMP> {
   using Base::key_comp;
   using Base::value_comp;
 
+  /**
+   * @brief Build the set from the sorted keys [first, last) in O(n).
+   *
+   * Each key is appended at the end of the tree by the hint, so there is no
+   * descent from the root, and the btree splits the rightmost node leaving
+   * the left one full, so the nodes are filled full as the bottom up build.
+   *
+   * @tparam ITER The input iterator.
+   * @param first
+   * @param last
+   * @return Set<KEY, CMP> The new set.
+   */
+  template <class ITER>
+  static Set<KEY, CMP> fromSorted(ITER first, ITER last) {
+    Set<KEY, CMP> result;
+    result.appendSorted(first, last);
+    return result;
+  }
+
+  /**
+   * @brief Append the sorted keys [first, last), they are not less than the
+   * keys in the set, such as the monotone keys read from the sorted file.The
+   * key breaking the order is still inserted correctly, only without the
+   * speed up.For the equal keys, the first one is kept.
+   *
+   * @tparam ITER The input iterator.
+   * @param first
+   * @param last
+   */
+  template <class ITER>
+  void appendSorted(ITER first, ITER last) {
+    for (; first != last; ++first) {
+      this->emplace_hint(this->end(), *first);
+    }
+  }
+
   /**
    * @brief Removes all items from this set that are contained in the other set.
    *
+   * The small other set is erased item by item, otherwise the difference is
+   * merged into a new tree in linear time.
+   *
    * Returns a reference to this set.
    */
   Set<KEY, CMP>& subtract(const Set<KEY, CMP>& other) {
-    for (const auto& e : other) {
-      erase(e);
+    if (isMuchSmaller(other, *this)) {
+      for (const auto& e : other) {
+        erase(e);
+      }
+    } else {
+      Set<KEY, CMP> result = difference(*this, other);
+      swap(result);
     }
-
     return *this;
   }
   /**
    * @brief Insert all items from the other set.
    *
+   * The small other set is inserted item by item, otherwise the union is
+   * merged into a new tree in linear time.
+   *
    * @param other
    * @return HSet<KEY>& This set after unite the other.
    */
   Set<KEY, CMP>& unite(const Set<KEY, CMP>& other) {
-    for (const KEY& e : other) {
-      insert(e);
+    if (isMuchSmaller(other, *this)) {
+      for (const KEY& e : other) {
+        insert(e);
+      }
+    } else {
+      Set<KEY, CMP> result = setUnion(*this, other);
+      swap(result);
     }
     return *this;
   }
@@ -113,22 +175,215 @@ class Set : public absl::btree_set<KEY, CMP> {
    * @return HSet<KEY>& This set after intersect the other.
    */
   Set<KEY, CMP>& intersect(const Set<KEY, CMP>& other) {
-    Set<KEY, CMP> copy1;
-    Set<KEY, CMP> copy2;
-    if (size() <= other.size()) {
-      copy1 = *this;
-      copy2 = other;
-    } else {
-      copy1 = other;
-      copy2 = *this;
-      *this = copy1;
+    Set<KEY, CMP> result = intersection(*this, other);
+    swap(result);
+    return *this;
+  }
+
+  /**
+   * @brief The union of the two sets merged in linear time, the result tree
+   * is built by appending at the end.
+   *
+   * @param set1
+   * @param set2
+   * @return Set<KEY, CMP> The new set.
+   */
+  static Set<KEY, CMP> setUnion(const Set<KEY, CMP>& set1,
+                                const Set<KEY, CMP>& set2) {
+    Set<KEY, CMP> result(set1.key_comp());
+    auto comp = set1.key_comp();
+    auto iter1 = set1.begin();
+    auto iter2 = set2.begin();
+    while (iter1 != set1.end() && iter2 != set2.end()) {
+      if (comp(*iter1, *iter2)) {
+        result.emplace_hint(result.end(), *iter1++);
+      } else if (comp(*iter2, *iter1)) {
+        result.emplace_hint(result.end(), *iter2++);
+      } else {
+        result.emplace_hint(result.end(), *iter1++);
+        ++iter2;
+      }
     }
-    for (const auto& e : copy1) {
-      if (!copy2.contains(e)) {
-        erase(e);
+    for (; iter1 != set1.end(); ++iter1) {
+      result.emplace_hint(result.end(), *iter1);
+    }
+    for (; iter2 != set2.end(); ++iter2) {
+      result.emplace_hint(result.end(), *iter2);
+    }
+    return result;
+  }
+
+  /**
+   * @brief The intersection of the two sets.The items of the smaller set are
+   * searched in the larger one in ascending order, the search steps forward
+   * from the last position a few times and falls back to the lookup from the
+   * tree root when the larger set is much larger, so the cost is O(m log n)
+   * rather than O(m + n).
+   *
+   * @param set1
+   * @param set2
+   * @return Set<KEY, CMP> The new set.
+   */
+  static Set<KEY, CMP> intersection(const Set<KEY, CMP>& set1,
+                                    const Set<KEY, CMP>& set2) {
+    const Set<KEY, CMP>& small = set1.size() <= set2.size() ? set1 : set2;
+    const Set<KEY, CMP>& big = set1.size() <= set2.size() ? set2 : set1;
+    Set<KEY, CMP> result(set1.key_comp());
+    auto comp = set1.key_comp();
+    bool gallop = isMuchSmaller(small, big);
+    auto iter = big.begin();
+    for (const KEY& key : small) {
+      iter = seek(big, iter, key, gallop);
+      if (iter == big.end()) {
+        break;
+      }
+      if (!comp(key, *iter)) {
+        result.emplace_hint(result.end(), key);
+        ++iter;
       }
     }
-    return *this;
+    return result;
+  }
+
+  /**
+   * @brief The items of set1 not in set2, the search in set2 gallops when
+   * set2 is much larger.
+   *
+   * @param set1
+   * @param set2
+   * @return Set<KEY, CMP> The new set.
+   */
+  static Set<KEY, CMP> difference(const Set<KEY, CMP>& set1,
+                                  const Set<KEY, CMP>& set2) {
+    Set<KEY, CMP> result(set1.key_comp());
+    auto comp = set1.key_comp();
+    bool gallop = isMuchSmaller(set1, set2);
+    auto iter = set2.begin();
+    for (const KEY& key : set1) {
+      iter = seek(set2, iter, key, gallop);
+      if (iter == set2.end() || comp(key, *iter)) {
+        result.emplace_hint(result.end(), key);
+      } else {
+        ++iter;
+      }
+    }
+    return result;
+  }
+
+  /**
+   * @brief The intersection of many sets, such as the cells common to the
+   * nets.
+   *
+   * The sets are ordered by size.Each item of the smallest set is searched in
+   * the others from the smallest one, with one forward cursor per set
+   * galloping as intersection, and it stops at the first set missing it.The
+   * result is appended once, without the pairwise intermediate sets.The
+   * items of the smallest set are split among the threads.
+   *
+   * @param sets The sets, nullptr is the empty set.
+   * @param num_threads The thread number, zero or negative means the hardware
+   * concurrency.
+   * @return Set<KEY, CMP> The new set.
+   */
+  static Set<KEY, CMP> intersectAll(
+      const std::vector<const Set<KEY, CMP>*>& sets, int num_threads = 1) {
+    std::vector<const Set<KEY, CMP>*> sorted_sets = sortBySize(sets);
+    if (sorted_sets.empty() || sorted_sets.front() == nullptr ||
+        sorted_sets.front()->empty()) {
+      return Set<KEY, CMP>();
+    }
+    const Set<KEY, CMP>& smallest = *sorted_sets.front();
+    auto comp = smallest.key_comp();
+    std::vector<const KEY*> keys;
+    keys.reserve(smallest.size());
+    for (const KEY& key : smallest) {
+      keys.push_back(&key);
+    }
+    std::vector<bool> gallop;
+    for (const auto* set : sorted_sets) {
+      gallop.push_back(isMuchSmaller(smallest, *set));
+    }
+
+    std::vector<std::vector<const KEY*>> chunk_results(
+        std::max(num_threads <= 0 ? defaultThreadNum() : num_threads, 1));
+    parallelFor(keys.size(), num_threads, [&](int chunk, size_t begin,
+                                              size_t end) {
+      std::vector<const_iterator> cursors;
+      for (size_t j = 1; j < sorted_sets.size(); ++j) {
+        cursors.push_back(sorted_sets[j]->lower_bound(*keys[begin]));
+      }
+      for (size_t i = begin; i < end; ++i) {
+        const KEY& key = *keys[i];
+        bool found = true;
+        for (size_t j = 1; j < sorted_sets.size() && found; ++j) {
+          const Set<KEY, CMP>& set = *sorted_sets[j];
+          auto& cursor = cursors[j - 1];
+          cursor = seek(set, cursor, key, gallop[j]);
+          if (cursor == set.end()) {
+            return;
+          }
+          found = !comp(key, *cursor);
+        }
+        if (found) {
+          chunk_results[chunk].push_back(&key);
+        }
+      }
+    });
+    return appendAll(comp, chunk_results);
+  }
+
+  /**
+   * @brief The union of many sets.
+   *
+   * The sets are merged by a min heap of one cursor per set, so the cost is
+   * O(n log k) for the total n items of the k sets, and the result is
+   * appended once.With multiple threads, the key range is split by the
+   * quantiles of the largest set, and each thread merges its own key range.
+   *
+   * @param sets The sets, nullptr is the empty set.
+   * @param num_threads The thread number, zero or negative means the hardware
+   * concurrency.
+   * @return Set<KEY, CMP> The new set.
+   */
+  static Set<KEY, CMP> uniteAll(const std::vector<const Set<KEY, CMP>*>& sets,
+                                int num_threads = 1) {
+    std::vector<const Set<KEY, CMP>*> sorted_sets;
+    for (const auto* set : sortBySize(sets)) {
+      if (set != nullptr && !set->empty()) {
+        sorted_sets.push_back(set);
+      }
+    }
+    if (sorted_sets.empty()) {
+      return Set<KEY, CMP>();
+    }
+    const Set<KEY, CMP>& largest = *sorted_sets.back();
+    auto comp = largest.key_comp();
+    if (num_threads <= 0) {
+      num_threads = defaultThreadNum();
+    }
+    size_t num_chunks = std::min<size_t>(num_threads, largest.size());
+    // The chunk c merges the keys in [splitters[c - 1], splitters[c]), the
+    // first chunk is unbounded below and the last one above.
+    std::vector<const KEY*> splitters;
+    size_t index = 0;
+    for (const KEY& key : largest) {
+      if (index != 0 && index * num_chunks / largest.size() !=
+                            (index - 1) * num_chunks / largest.size()) {
+        splitters.push_back(&key);
+      }
+      ++index;
+    }
+
+    std::vector<std::vector<const KEY*>> chunk_results(num_chunks);
+    parallelFor(num_chunks, static_cast<int>(num_chunks),
+                [&](int, size_t first_chunk, size_t last_chunk) {
+                  for (size_t c = first_chunk; c < last_chunk; ++c) {
+                    mergeRange(sorted_sets, c == 0 ? nullptr : splitters[c - 1],
+                               c + 1 == num_chunks ? nullptr : splitters[c],
+                               &chunk_results[c]);
+                  }
+                });
+    return appendAll(comp, chunk_results);
   }
 
   /**
@@ -210,14 +465,10 @@ class Set : public absl::btree_set<KEY, CMP> {
     return *this;
   }
   inline Set<KEY, CMP> operator|(const Set<KEY, CMP>& other) const {
-    Set<KEY, CMP> result = *this;
-    result |= other;
-    return result;
+    return setUnion(*this, other);
   }
   inline Set<KEY, CMP> operator&(const Set<KEY, CMP>& other) const {
-    Set<KEY, CMP> result = *this;
-    result &= other;
-    return result;
+    return intersection(*this, other);
   }
   inline Set<KEY, CMP> operator+(Set<KEY, CMP>& other) const {
     Set<KEY, CMP> result = *this;
@@ -225,9 +476,7 @@ class Set : public absl::btree_set<KEY, CMP> {
     return result;
   }
   inline Set<KEY, CMP> operator-(const Set<KEY, CMP>& other) const {
-    Set<KEY, CMP> result = *this;
-    result -= other;
-    return result;
+    return difference(*this, other);
   }
 
   /**
@@ -237,7 +486,8 @@ class Set : public absl::btree_set<KEY, CMP> {
    * @return true when has key.
    * @return false when do not has key.
    */
-  bool hasKey(const KEY key) const {
+  template <class K = KEY>
+  bool hasKey(const key_arg<K>& key) const {
     auto find_iter = this->find(key);
     return find_iter != this->end();
   }
@@ -349,6 +599,92 @@ class Set : public absl::btree_set<KEY, CMP> {
     const Set<KEY, CMP>* _container = nullptr;
     typename Set<KEY, CMP>::const_iterator _iter;
   };
+
+ private:
+  // The merge gallops when the larger set is this times the smaller one.
+  static constexpr size_t kGallopRatio = 16;
+  // The steps tried before the tree lookup while galloping.
+  static constexpr int kGallopSteps = 4;
+
+  static bool isMuchSmaller(const Set<KEY, CMP>& small,
+                            const Set<KEY, CMP>& big) {
+    // The btree size_type is signed.
+    return static_cast<size_t>(small.size()) * kGallopRatio <
+           static_cast<size_t>(big.size());
+  }
+
+  // Return the first item of set not less than key, starting from iter which
+  // is not after the result.
+  static const_iterator seek(const Set<KEY, CMP>& set, const_iterator iter,
+                             const KEY& key, bool gallop) {
+    auto comp = set.key_comp();
+    if (!gallop) {
+      while (iter != set.end() && comp(*iter, key)) {
+        ++iter;
+      }
+      return iter;
+    }
+    for (int i = 0; i < kGallopSteps; ++i) {
+      if (iter == set.end() || !comp(*iter, key)) {
+        return iter;
+      }
+      ++iter;
+    }
+    return set.lower_bound(key);
+  }
+
+  // The sets ordered by size, nullptr first as the empty set.
+  static std::vector<const Set<KEY, CMP>*> sortBySize(
+      const std::vector<const Set<KEY, CMP>*>& sets) {
+    std::vector<const Set<KEY, CMP>*> sorted_sets = sets;
+    std::stable_sort(sorted_sets.begin(), sorted_sets.end(),
+                     [](const Set<KEY, CMP>* a, const Set<KEY, CMP>* b) {
+                       return (a ? a->size() : 0) < (b ? b->size() : 0);
+                     });
+    return sorted_sets;
+  }
+
+  // Merge the keys in [lower, upper) of the sets by the min heap, nullptr
+  // bound is unbounded.
+  static void mergeRange(const std::vector<const Set<KEY, CMP>*>& sets,
+                         const KEY* lower, const KEY* upper,
+                         std::vector<const KEY*>* result) {
+    using Cursor = std::pair<const_iterator, const_iterator>;
+    auto comp = sets.front()->key_comp();
+    auto greater = [&comp](const Cursor& a, const Cursor& b) {
+      return comp(*b.first, *a.first);
+    };
+    std::priority_queue<Cursor, std::vector<Cursor>, decltype(greater)> heap(
+        greater);
+    for (const auto* set : sets) {
+      auto first = lower ? set->lower_bound(*lower) : set->begin();
+      auto last = upper ? set->lower_bound(*upper) : set->end();
+      if (first != last) {
+        heap.emplace(first, last);
+      }
+    }
+    while (!heap.empty()) {
+      Cursor cursor = heap.top();
+      heap.pop();
+      if (result->empty() || comp(*result->back(), *cursor.first)) {
+        result->push_back(&*cursor.first);
+      }
+      if (++cursor.first != cursor.second) {
+        heap.push(cursor);
+      }
+    }
+  }
+
+  static Set<KEY, CMP> appendAll(
+      const CMP& comp, const std::vector<std::vector<const KEY*>>& chunks) {
+    Set<KEY, CMP> result(comp);
+    for (const auto& chunk : chunks) {
+      for (const KEY* key : chunk) {
+        result.emplace_hint(result.end(), *key);
+      }
+    }
+    return result;
+  }
 };
 
 template <class KEY, class CMP>
@@ -559,6 +895,42 @@ class Multiset : public absl::btree_multiset<KEY, CMP> {
   using Base::get_allocator;
   using Base::key_comp;
   using Base::value_comp;
+
+  /**
+   * @brief Build the set from the sorted keys [first, last) in O(n).
+   *
+   * Each key is appended at the end of the tree by the hint, so there is no
+   * descent from the root, and the btree splits the rightmost node leaving
+   * the left one full, so the nodes are filled full as the bottom up build.
+   *
+   * @tparam ITER The input iterator.
+   * @param first
+   * @param last
+   * @return Multiset<KEY, CMP> The new set.
+   */
+  template <class ITER>
+  static Multiset<KEY, CMP> fromSorted(ITER first, ITER last) {
+    Multiset<KEY, CMP> result;
+    result.appendSorted(first, last);
+    return result;
+  }
+
+  /**
+   * @brief Append the sorted keys [first, last), they are not less than the
+   * keys in the set, such as the monotone keys read from the sorted file.The
+   * key breaking the order is still inserted correctly, only without the
+   * speed up.The equal keys keep their order.
+   *
+   * @tparam ITER The input iterator.
+   * @param first
+   * @param last
+   */
+  template <class ITER>
+  void appendSorted(ITER first, ITER last) {
+    for (; first != last; ++first) {
+      this->emplace_hint(this->end(), *first);
+    }
+  }
 };
 
 template <typename KEY, typename CMP>
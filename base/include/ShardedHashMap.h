@@ -0,0 +1,263 @@
+/**
+ * @file ShardedHashMap.h
+ * @author simin tao (taosm@pcl.ac.cn)
+ * @brief The sharded hash map and set built in parallel for the eda project.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#include "HashMap.h"
+#include "HashSet.h"
+#include "Parallel.h"
+
+namespace pcl {
+
+// The input smaller than it is inserted by one thread, the thread start up
+// costs more than the insert.
+constexpr size_t kMinParallelInsert = 1 << 14;
+
+/**
+ * @brief The hash table split into the independent shards by the hash of the
+ * key, each shard is a whole swiss table.
+ *
+ * The shards own the disjoint keys, so the threads fill the shards of their
+ * own without any lock and without any serial step.The element is found by
+ * hashing the key once to choose the shard and looking up the shard with the
+ * same hash, so a lookup only costs one multiply more than the plain table.
+ * The iteration visits the shards one after another, and the elements can
+ * not be erased.
+ *
+ * ShardedHashMap<std::string, Net*> nets;
+ * nets.insertParallel(net_pairs.begin(), net_pairs.end());
+ * const auto* net = nets.find("n1");
+ *
+ * @tparam TABLE The HashMap or HashSet of the shard.
+ */
+template <class TABLE>
+class ShardedHashTable {
+ public:
+  using key_type = typename TABLE::key_type;
+  using value_type = typename TABLE::value_type;
+  using hasher = typename TABLE::hasher;
+
+  static constexpr int kMaxShardBits = 16;
+
+  /**
+   * @brief Construct the empty table.
+   *
+   * @param num_shards The shard number, rounded up to the power of two, more
+   * shards than threads balance the skewed keys better.
+   */
+  explicit ShardedHashTable(int num_shards = 64) {
+    while (_shard_bits < kMaxShardBits && (1 << _shard_bits) < num_shards) {
+      ++_shard_bits;
+    }
+    _shards.resize(static_cast<size_t>(1) << _shard_bits);
+  }
+
+  size_t numShards() const { return _shards.size(); }
+  const TABLE& shard(size_t index) const { return _shards[index]; }
+
+  size_t size() const {
+    size_t num = 0;
+    for (const TABLE& table : _shards) {
+      num += table.size();
+    }
+    return num;
+  }
+  bool empty() const { return size() == 0; }
+
+  void clear() {
+    for (TABLE& table : _shards) {
+      table.clear();
+    }
+  }
+
+  /**
+   * @brief Find the element of the key.
+   *
+   * @param key
+   * @return const value_type* The element, or nullptr if not found.
+   */
+  const value_type* find(const key_type& key) const {
+    size_t hash = _hash(key);
+    const TABLE& table = _shards[shardIndex(hash)];
+    auto iter = table.find(key, hash);
+    return iter == table.end() ? nullptr : &*iter;
+  }
+  bool hasKey(const key_type& key) const { return find(key) != nullptr; }
+
+  /**
+   * @brief Call the func(const value_type&) on each element, the shards are
+   * visited in order.
+   */
+  template <class FUNC>
+  void forEach(FUNC&& func) const {
+    for (const TABLE& table : _shards) {
+      for (const auto& element : table) {
+        func(element);
+      }
+    }
+  }
+
+  /**
+   * @brief Insert the elements [first, last) with multiple threads, the later
+   * element of the same key overwrites the former one in the map.
+   *
+   * The threads hash the keys and count them by the shard, each thread then
+   * reserves its shards once and inserts their elements in the input order.
+   * The input is scanned once by every thread to pick its elements, which
+   * only reads the two byte shard index of each element.
+   *
+   * @tparam ITER The random access iterator of the keys or (key, value)
+   * pairs.
+   * @param first
+   * @param last
+   * @param num_threads The thread number, zero or negative means the hardware
+   * concurrency.
+   */
+  template <class ITER>
+  void insertParallel(ITER first, ITER last, int num_threads = 0) {
+    size_t n = static_cast<size_t>(std::distance(first, last));
+    if (n == 0) {
+      return;
+    }
+    if (num_threads <= 0) {
+      num_threads = defaultThreadNum();
+    }
+    if (n < kMinParallelInsert) {
+      num_threads = 1;
+    }
+    const size_t num_shards = numShards();
+    const size_t num_chunks = std::min(static_cast<size_t>(num_threads), n);
+    std::vector<uint16_t> shard_of(n);
+    std::vector<size_t> counts(num_chunks * num_shards, 0);
+    parallelFor(n, num_threads, [&](int chunk, size_t begin, size_t end) {
+      size_t* chunk_counts = counts.data() + chunk * num_shards;
+      for (size_t i = begin; i < end; ++i) {
+        size_t s = shardIndex(_hash(keyOf(first[i])));
+        shard_of[i] = static_cast<uint16_t>(s);
+        ++chunk_counts[s];
+      }
+    });
+
+    parallelFor(num_shards, num_threads, [&](int, size_t first_shard,
+                                             size_t last_shard) {
+      for (size_t s = first_shard; s < last_shard; ++s) {
+        size_t count = 0;
+        for (size_t c = 0; c < num_chunks; ++c) {
+          count += counts[c * num_shards + s];
+        }
+        _shards[s].reserve(_shards[s].size() + count);
+      }
+      for (size_t i = 0; i < n; ++i) {
+        if (shard_of[i] >= first_shard && shard_of[i] < last_shard) {
+          insertOrAssign(&_shards[shard_of[i]], first[i]);
+        }
+      }
+    });
+  }
+
+  /**
+   * @brief Insert the elements of the other table with multiple threads, the
+   * existed key keeps its element.With the same shard number, the shard i of
+   * the other is united into the shard i directly.
+   *
+   * @param other
+   * @param num_threads The thread number, zero or negative means the hardware
+   * concurrency.
+   * @return ShardedHashTable& This table after unite the other.
+   */
+  ShardedHashTable& uniteParallel(const ShardedHashTable& other,
+                                  int num_threads = 0) {
+    const bool same_shards = other.numShards() == numShards();
+    parallelFor(numShards(), num_threads, [&](int, size_t first_shard,
+                                              size_t last_shard) {
+      if (same_shards) {
+        for (size_t s = first_shard; s < last_shard; ++s) {
+          _shards[s].insert(other._shards[s].begin(), other._shards[s].end());
+        }
+        return;
+      }
+      for (const TABLE& table : other._shards) {
+        for (const auto& element : table) {
+          size_t s = shardIndex(_hash(keyOf(element)));
+          if (s >= first_shard && s < last_shard) {
+            _shards[s].insert(element);
+          }
+        }
+      }
+    });
+    return *this;
+  }
+
+  /**
+   * @brief Copy the elements into one plain table, it is sequential and
+   * rehashes every key, so it is only for the caller which needs the TABLE.
+   *
+   * @return TABLE
+   */
+  TABLE flatten() const {
+    TABLE table;
+    table.reserve(size());
+    for (const TABLE& shard : _shards) {
+      table.insert(shard.begin(), shard.end());
+    }
+    return table;
+  }
+
+ private:
+  // The hash is multiplied by the golden ratio before its top bits pick the
+  // shard, so the weak hash such as the identity still spreads the shards.
+  size_t shardIndex(size_t hash) const {
+    if (_shard_bits == 0) {
+      return 0;
+    }
+    uint64_t mixed = static_cast<uint64_t>(hash) * 0x9E3779B97F4A7C15ull;
+    return static_cast<size_t>(mixed >> (64 - _shard_bits));
+  }
+
+  template <class ELEMENT>
+  static const key_type& keyOf(const ELEMENT& element) {
+    if constexpr (detail::IsHashMapTable<TABLE>::value) {
+      return element.first;
+    } else {
+      return element;
+    }
+  }
+
+  template <class ELEMENT>
+  static void insertOrAssign(TABLE* table, const ELEMENT& element) {
+    if constexpr (detail::IsHashMapTable<TABLE>::value) {
+      table->insert_or_assign(element.first, element.second);
+    } else {
+      table->insert(element);
+    }
+  }
+
+  hasher _hash;
+  int _shard_bits = 0;
+  std::vector<TABLE> _shards;
+};
+
+template <class KEY, class VALUE,
+          class HASH = typename absl::flat_hash_map<KEY, VALUE>::hasher,
+          class EQ = typename absl::flat_hash_map<KEY, VALUE>::key_equal>
+using ShardedHashMap = ShardedHashTable<HashMap<KEY, VALUE, HASH, EQ>>;
+
+template <class KEY, class HASH = typename absl::flat_hash_set<KEY>::hasher,
+          class EQ = typename absl::flat_hash_set<KEY>::key_equal>
+using ShardedHashSet = ShardedHashTable<HashSet<KEY, HASH, EQ>>;
+
+}  // namespace pcl
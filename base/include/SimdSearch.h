@@ -0,0 +1,356 @@
+/**
+ * @file SimdSearch.h
+ * @author simin tao (taosm@pcl.ac.cn)
+ * @brief The simd search kernels of the contiguous elements for the eda
+ * project.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define PCL_SIMD_SEARCH 1
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#if defined(__SSE4_1__)
+#include <smmintrin.h>
+#endif
+#define PCL_SIMD_SEARCH 1
+#else
+#define PCL_SIMD_SEARCH 0
+#endif
+
+namespace pcl {
+
+namespace detail {
+
+/**
+ * @brief The register bytes of the simd kernels selected at compile time, 32
+ * with AVX2(-mavx2 or -march), 16 with SSE2, which is always on x86-64, zero
+ * without simd, then the kernels are the scalar loops.
+ */
+#if defined(__AVX2__)
+constexpr size_t kSimdBytes = 32;
+using SimdReg = __m256i;
+#elif defined(__SSE2__)
+constexpr size_t kSimdBytes = 16;
+using SimdReg = __m128i;
+#else
+constexpr size_t kSimdBytes = 0;
+#endif
+
+/**
+ * @brief Whether the T is searched by the simd kernels, that is the arithmetic
+ * or pointer T of 1, 2, 4 or 8 bytes.The float and double are compared as the
+ * floating point, so the NaN is never found and 0.0 equals -0.0 as the
+ * operator==, the others are compared by the bits.
+ */
+template <typename T>
+constexpr bool kSimdSearchable =
+    kSimdBytes != 0 &&
+    (std::is_arithmetic<T>::value || std::is_pointer<T>::value) &&
+    (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+
+#if PCL_SIMD_SEARCH
+
+// The unsigned integer of the same bytes as T.
+template <size_t BYTES>
+struct SimdLane;
+template <>
+struct SimdLane<1> {
+  using type = uint8_t;
+};
+template <>
+struct SimdLane<2> {
+  using type = uint16_t;
+};
+template <>
+struct SimdLane<4> {
+  using type = uint32_t;
+};
+template <>
+struct SimdLane<8> {
+  using type = uint64_t;
+};
+
+inline SimdReg simdLoad(const void* p) {
+#if defined(__AVX2__)
+  return _mm256_loadu_si256(static_cast<const __m256i*>(p));
+#else
+  return _mm_loadu_si128(static_cast<const __m128i*>(p));
+#endif
+}
+
+// Broadcast the bits of the value to all lanes.
+template <typename T>
+SimdReg simdSplat(const T& value) {
+  typename SimdLane<sizeof(T)>::type bits;
+  std::memcpy(&bits, &value, sizeof(T));
+#if defined(__AVX2__)
+  if constexpr (sizeof(T) == 1) {
+    return _mm256_set1_epi8(static_cast<char>(bits));
+  } else if constexpr (sizeof(T) == 2) {
+    return _mm256_set1_epi16(static_cast<short>(bits));
+  } else if constexpr (sizeof(T) == 4) {
+    return _mm256_set1_epi32(static_cast<int>(bits));
+  } else {
+    return _mm256_set1_epi64x(static_cast<long long>(bits));
+  }
+#else
+  if constexpr (sizeof(T) == 1) {
+    return _mm_set1_epi8(static_cast<char>(bits));
+  } else if constexpr (sizeof(T) == 2) {
+    return _mm_set1_epi16(static_cast<short>(bits));
+  } else if constexpr (sizeof(T) == 4) {
+    return _mm_set1_epi32(static_cast<int>(bits));
+  } else {
+    return _mm_set1_epi64x(static_cast<long long>(bits));
+  }
+#endif
+}
+
+// The all ones lanes where a equals b.
+template <typename T>
+SimdReg simdEqual(SimdReg a, SimdReg b) {
+#if defined(__AVX2__)
+  if constexpr (std::is_same<T, float>::value) {
+    return _mm256_castps_si256(_mm256_cmp_ps(
+        _mm256_castsi256_ps(a), _mm256_castsi256_ps(b), _CMP_EQ_OQ));
+  } else if constexpr (std::is_same<T, double>::value) {
+    return _mm256_castpd_si256(_mm256_cmp_pd(
+        _mm256_castsi256_pd(a), _mm256_castsi256_pd(b), _CMP_EQ_OQ));
+  } else if constexpr (sizeof(T) == 1) {
+    return _mm256_cmpeq_epi8(a, b);
+  } else if constexpr (sizeof(T) == 2) {
+    return _mm256_cmpeq_epi16(a, b);
+  } else if constexpr (sizeof(T) == 4) {
+    return _mm256_cmpeq_epi32(a, b);
+  } else {
+    return _mm256_cmpeq_epi64(a, b);
+  }
+#else
+  if constexpr (std::is_same<T, float>::value) {
+    return _mm_castps_si128(_mm_cmpeq_ps(_mm_castsi128_ps(a),
+                                         _mm_castsi128_ps(b)));
+  } else if constexpr (std::is_same<T, double>::value) {
+    return _mm_castpd_si128(_mm_cmpeq_pd(_mm_castsi128_pd(a),
+                                         _mm_castsi128_pd(b)));
+  } else if constexpr (sizeof(T) == 1) {
+    return _mm_cmpeq_epi8(a, b);
+  } else if constexpr (sizeof(T) == 2) {
+    return _mm_cmpeq_epi16(a, b);
+  } else if constexpr (sizeof(T) == 4) {
+    return _mm_cmpeq_epi32(a, b);
+  } else {
+#if defined(__SSE4_1__)
+    return _mm_cmpeq_epi64(a, b);
+#else
+    // The 64 bits lanes are equal if both 32 bits halves are equal.
+    __m128i eq32 = _mm_cmpeq_epi32(a, b);
+    return _mm_and_si128(eq32,
+                         _mm_shuffle_epi32(eq32, _MM_SHUFFLE(2, 3, 0, 1)));
+#endif
+  }
+#endif
+}
+
+inline SimdReg simdOr(SimdReg a, SimdReg b) {
+#if defined(__AVX2__)
+  return _mm256_or_si256(a, b);
+#else
+  return _mm_or_si128(a, b);
+#endif
+}
+
+// The byte mask of the register, each all ones lane sets sizeof(T) bits.
+inline uint32_t simdMask(SimdReg a) {
+#if defined(__AVX2__)
+  return static_cast<uint32_t>(_mm256_movemask_epi8(a));
+#else
+  return static_cast<uint32_t>(_mm_movemask_epi8(a));
+#endif
+}
+
+// The lane counters add one in the all ones lanes of eq.
+template <typename T>
+SimdReg simdCountLanes(SimdReg counters, SimdReg eq) {
+#if defined(__AVX2__)
+  if constexpr (sizeof(T) == 1) {
+    return _mm256_sub_epi8(counters, eq);
+  } else if constexpr (sizeof(T) == 2) {
+    return _mm256_sub_epi16(counters, eq);
+  } else if constexpr (sizeof(T) == 4) {
+    return _mm256_sub_epi32(counters, eq);
+  } else {
+    return _mm256_sub_epi64(counters, eq);
+  }
+#else
+  if constexpr (sizeof(T) == 1) {
+    return _mm_sub_epi8(counters, eq);
+  } else if constexpr (sizeof(T) == 2) {
+    return _mm_sub_epi16(counters, eq);
+  } else if constexpr (sizeof(T) == 4) {
+    return _mm_sub_epi32(counters, eq);
+  } else {
+    return _mm_sub_epi64(counters, eq);
+  }
+#endif
+}
+
+template <typename T>
+size_t simdSumLanes(SimdReg counters) {
+  using Lane = typename SimdLane<sizeof(T)>::type;
+  Lane lanes[kSimdBytes / sizeof(T)];
+  std::memcpy(lanes, &counters, kSimdBytes);
+  size_t sum = 0;
+  for (Lane lane : lanes) {
+    sum += lane;
+  }
+  return sum;
+}
+
+inline SimdReg simdZero() {
+#if defined(__AVX2__)
+  return _mm256_setzero_si256();
+#else
+  return _mm_setzero_si128();
+#endif
+}
+
+#endif
+
+}  // namespace detail
+
+/**
+ * @brief Find the first element equal to the value in [first, last).
+ *
+ * The simd kernel compares one register of elements at once for the
+ * searchable T, and tests four registers in one branch for the long range,
+ * the other T falls back to std::find.
+ *
+ * @return const T* The found element, last if not found.
+ */
+template <typename T>
+const T* simdFind(const T* first, const T* last, const T& value) {
+#if PCL_SIMD_SEARCH
+  if constexpr (detail::kSimdSearchable<T>) {
+    constexpr size_t kLanes = detail::kSimdBytes / sizeof(T);
+    auto needle = detail::simdSplat(value);
+    while (static_cast<size_t>(last - first) >= 4 * kLanes) {
+      auto eq0 = detail::simdEqual<T>(detail::simdLoad(first), needle);
+      auto eq1 = detail::simdEqual<T>(detail::simdLoad(first + kLanes), needle);
+      auto eq2 =
+          detail::simdEqual<T>(detail::simdLoad(first + 2 * kLanes), needle);
+      auto eq3 =
+          detail::simdEqual<T>(detail::simdLoad(first + 3 * kLanes), needle);
+      auto any = detail::simdOr(detail::simdOr(eq0, eq1),
+                                detail::simdOr(eq2, eq3));
+      if (detail::simdMask(any) != 0) {
+        break;
+      }
+      first += 4 * kLanes;
+    }
+    while (static_cast<size_t>(last - first) >= kLanes) {
+      uint32_t mask = detail::simdMask(
+          detail::simdEqual<T>(detail::simdLoad(first), needle));
+      if (mask != 0) {
+        return first + __builtin_ctz(mask) / sizeof(T);
+      }
+      first += kLanes;
+    }
+  }
+#endif
+  return std::find(first, last, value);
+}
+
+/**
+ * @brief Count the elements equal to the value in [first, last).
+ *
+ * The simd kernel counts in the lanes of the register, and sums the lanes
+ * before the lane counter overflows.
+ *
+ * @return size_t
+ */
+template <typename T>
+size_t simdCount(const T* first, const T* last, const T& value) {
+  size_t num = 0;
+#if PCL_SIMD_SEARCH
+  if constexpr (detail::kSimdSearchable<T>) {
+    constexpr size_t kLanes = detail::kSimdBytes / sizeof(T);
+    constexpr size_t kMaxRegs = sizeof(T) == 1   ? 0xFF
+                                : sizeof(T) == 2 ? 0xFFFF
+                                                 : 0xFFFFFFFF;
+    auto needle = detail::simdSplat(value);
+    while (static_cast<size_t>(last - first) >= kLanes) {
+      size_t num_regs =
+          std::min(kMaxRegs, static_cast<size_t>(last - first) / kLanes);
+      auto counters = detail::simdZero();
+      for (size_t i = 0; i < num_regs; ++i, first += kLanes) {
+        counters = detail::simdCountLanes<T>(
+            counters, detail::simdEqual<T>(detail::simdLoad(first), needle));
+      }
+      num += detail::simdSumLanes<T>(counters);
+    }
+  }
+#endif
+  return num + static_cast<size_t>(std::count(first, last, value));
+}
+
+/**
+ * @brief Find the last element equal to the value in [first, last), the
+ * elements are searched backward from last.
+ *
+ * @return const T* The found element, last if not found.
+ */
+template <typename T>
+const T* simdFindLast(const T* first, const T* last, const T& value) {
+  const T* end = last;
+#if PCL_SIMD_SEARCH
+  if constexpr (detail::kSimdSearchable<T>) {
+    constexpr size_t kLanes = detail::kSimdBytes / sizeof(T);
+    auto needle = detail::simdSplat(value);
+    while (static_cast<size_t>(end - first) >= 4 * kLanes) {
+      auto eq0 = detail::simdEqual<T>(detail::simdLoad(end - kLanes), needle);
+      auto eq1 =
+          detail::simdEqual<T>(detail::simdLoad(end - 2 * kLanes), needle);
+      auto eq2 =
+          detail::simdEqual<T>(detail::simdLoad(end - 3 * kLanes), needle);
+      auto eq3 =
+          detail::simdEqual<T>(detail::simdLoad(end - 4 * kLanes), needle);
+      auto any = detail::simdOr(detail::simdOr(eq0, eq1),
+                                detail::simdOr(eq2, eq3));
+      if (detail::simdMask(any) != 0) {
+        break;
+      }
+      end -= 4 * kLanes;
+    }
+    while (static_cast<size_t>(end - first) >= kLanes) {
+      uint32_t mask = detail::simdMask(
+          detail::simdEqual<T>(detail::simdLoad(end - kLanes), needle));
+      if (mask != 0) {
+        return end - kLanes + (31 - __builtin_clz(mask)) / sizeof(T);
+      }
+      end -= kLanes;
+    }
+  }
+#endif
+  while (end != first) {
+    if (*--end == value) {
+      return end;
+    }
+  }
+  return last;
+}
+
+}  // namespace pcl
@@ -0,0 +1,425 @@
+/**
+ * @file SnapshotHashMap.h
+ * @author simin tao (taosm@pcl.ac.cn)
+ * @brief The read mostly hash map with lock free snapshot for the eda project.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "HashMap.h"
+#include "absl/synchronization/mutex.h"
+
+namespace pcl {
+
+/**
+ * @brief The epoch based reclamation domain shared by the snapshot
+ * containers.
+ *
+ * Each reader thread owns a cache line aligned slot.Entering the read
+ * section publishes the current global epoch in the slot, leaving it marks
+ * the slot idle, so the reader only writes its own cache line.The writer
+ * retires the old version with the epoch advanced after the new version is
+ * published, and the old version can be freed when no slot holds an older
+ * epoch.
+ *
+ * The slot is assigned at the first read of the thread and recycled when the
+ * thread exits.The threads beyond kMaxSlots share one reader counter, which
+ * is still correct but blocks the reclamation while any of them is reading.
+ */
+class EpochDomain {
+ public:
+  static constexpr int kMaxSlots = 1024;
+  static constexpr uint64_t kIdle = std::numeric_limits<uint64_t>::max();
+
+  static EpochDomain& instance() {
+    static EpochDomain domain;
+    return domain;
+  }
+
+  void enter() {
+    ThreadState& state = threadState();
+    if (state.depth++ > 0) {
+      return;
+    }
+    if (state.slot == kUnassigned) {
+      state.slot = acquireSlot();
+    }
+    if (state.slot >= 0) {
+      _slots[state.slot].epoch.store(_epoch.load());
+    } else {
+      _overflow_readers.fetch_add(1);
+    }
+  }
+
+  void leave() {
+    ThreadState& state = threadState();
+    if (--state.depth > 0) {
+      return;
+    }
+    if (state.slot >= 0) {
+      _slots[state.slot].epoch.store(kIdle, std::memory_order_release);
+    } else {
+      _overflow_readers.fetch_sub(1, std::memory_order_release);
+    }
+  }
+
+  /**
+   * @brief Advance the global epoch, called after the new version is
+   * published.
+   *
+   * @return uint64_t The new epoch, the retired version is safe to free when
+   * minActiveEpoch() reaches it.
+   */
+  uint64_t advance() { return _epoch.fetch_add(1) + 1; }
+
+  /**
+   * @brief Get the oldest epoch announced by the active readers.
+   *
+   * @return uint64_t The oldest epoch, kIdle if no reader is active.
+   */
+  uint64_t minActiveEpoch() const {
+    if (_overflow_readers.load() != 0) {
+      return 0;
+    }
+    uint64_t min_epoch = kIdle;
+    int num_slots = _num_slots.load();
+    for (int i = 0; i < num_slots; ++i) {
+      min_epoch = std::min(min_epoch, _slots[i].epoch.load());
+    }
+    return min_epoch;
+  }
+
+ private:
+  static constexpr int kUnassigned = -2;
+
+  struct alignas(64) Slot {
+    std::atomic<uint64_t> epoch{kIdle};
+  };
+
+  struct ThreadState {
+    int slot = kUnassigned;
+    int depth = 0;
+    ~ThreadState() {
+      if (slot >= 0) {
+        EpochDomain::instance().releaseSlot(slot);
+      }
+    }
+  };
+
+  EpochDomain() = default;
+
+  static ThreadState& threadState() {
+    static thread_local ThreadState state;
+    return state;
+  }
+
+  int acquireSlot() {
+    absl::MutexLock lock(&_slot_mutex);
+    if (!_free_slots.empty()) {
+      int slot = _free_slots.back();
+      _free_slots.pop_back();
+      return slot;
+    }
+    int num_slots = _num_slots.load();
+    if (num_slots == kMaxSlots) {
+      return -1;
+    }
+    _num_slots.store(num_slots + 1);
+    return num_slots;
+  }
+
+  void releaseSlot(int slot) {
+    absl::MutexLock lock(&_slot_mutex);
+    _free_slots.push_back(slot);
+  }
+
+  alignas(64) std::atomic<uint64_t> _epoch{1};
+  alignas(64) std::atomic<int> _overflow_readers{0};
+  std::atomic<int> _num_slots{0};
+  Slot _slots[kMaxSlots];
+  absl::Mutex _slot_mutex;
+  std::vector<int> _free_slots;
+};
+
+/**
+ * @brief The RAII read section of the epoch domain.
+ */
+class EpochGuard {
+ public:
+  EpochGuard() { EpochDomain::instance().enter(); }
+  ~EpochGuard() { EpochDomain::instance().leave(); }
+
+  EpochGuard(const EpochGuard&) = delete;
+  EpochGuard& operator=(const EpochGuard&) = delete;
+};
+
+/**
+ * @brief A read mostly hash map, the readers look up the immutable published
+ * table without any lock.
+ *
+ * The table is a pcl::HashMap which is never modified after publishing.The
+ * writer copies the current table, applies a batch of updates to the copy,
+ * and publishes it by one atomic pointer exchange, so the readers always see a
+ * complete version.The writers are serialized by a mutex, and the old
+ * versions are reclaimed through the epoch domain after no reader can hold
+ * them.
+ *
+ * The reader is wait free and only writes its own epoch slot, the shared
+ * table pointer is read only between two publishes, so the reads do not
+ * bounce any cache line.Each write copies the whole table, so the updates
+ * should be grouped in one Batch or update() call.
+ *
+ * SnapshotHashMap<std::string, Cell*> cells;
+ * SnapshotHashMap<std::string, Cell*>::Batch batch;
+ * batch.insert("INV_X1", inv);
+ * cells.commit(std::move(batch));
+ * Cell* cell = cells.value("INV_X1");
+ *
+ * @tparam KEY Type of key.
+ * @tparam VALUE Type of value.
+ */
+template <class KEY, class VALUE,
+          class HASH = typename absl::flat_hash_map<KEY, VALUE>::hasher,
+          class EQ = typename absl::flat_hash_map<KEY, VALUE>::key_equal>
+class SnapshotHashMap {
+ public:
+  using Table = HashMap<KEY, VALUE, HASH, EQ>;
+  template <class K>
+  using key_arg = typename Table::template key_arg<K>;
+
+  /**
+   * @brief The consistent view of one version, the version is kept alive
+   * until the snapshot is destroyed.
+   */
+  class Snapshot {
+   public:
+    explicit Snapshot(const SnapshotHashMap& map) : _table(map.current()) {}
+    ~Snapshot() = default;
+
+    const Table& table() const { return *_table; }
+    const Table* operator->() const { return _table; }
+    const Table& operator*() const { return *_table; }
+
+   private:
+    EpochGuard _guard;
+    const Table* _table;
+  };
+
+  /**
+   * @brief The updates applied in order by one commit.
+   */
+  class Batch {
+   public:
+    void insert(const KEY& key, const VALUE& value) {
+      _updates.emplace_back(key, value);
+    }
+    void insert(KEY&& key, VALUE&& value) {
+      _updates.emplace_back(std::move(key), std::move(value));
+    }
+    void erase(const KEY& key) { _updates.emplace_back(key, std::nullopt); }
+    bool empty() const { return _updates.empty(); }
+    size_t size() const { return _updates.size(); }
+    void clear() { _updates.clear(); }
+
+   private:
+    friend class SnapshotHashMap;
+    std::vector<std::pair<KEY, std::optional<VALUE>>> _updates;
+  };
+
+  SnapshotHashMap() : _current(new Table()) {}
+  explicit SnapshotHashMap(Table&& table)
+      : _current(new Table(std::move(table))) {}
+
+  /**
+   * @brief Destroy the map, the caller must make sure there is no reader.
+   */
+  ~SnapshotHashMap() {
+    delete _current.load();
+    for (auto& retired : _retired) {
+      delete retired.first;
+    }
+  }
+
+  SnapshotHashMap(const SnapshotHashMap&) = delete;
+  SnapshotHashMap& operator=(const SnapshotHashMap&) = delete;
+
+  /**
+   * @brief Find out if key is in the map.
+   *
+   * @param key
+   * @return true if find out.
+   * @return false
+   */
+  template <class K = KEY>
+  bool hasKey(const key_arg<K>& key) const {
+    EpochGuard guard;
+    return current()->contains(key);
+  }
+
+  /**
+   * @brief Find the value corresponding to the key.
+   *
+   * @param key
+   * @param default_value The default return value if not found.
+   * @return const VALUE Return the found value.
+   */
+  template <class K = KEY>
+  const VALUE value(const key_arg<K>& key,
+                    const VALUE& default_value = VALUE()) const {
+    EpochGuard guard;
+    return current()->template value<K>(key, default_value);
+  }
+
+  /**
+   * @brief Find the value of the key and copy it out.
+   *
+   * @param key
+   * @param value The found value, unchanged if not found.
+   * @return true if find out.
+   * @return false
+   */
+  template <class K = KEY>
+  bool find(const key_arg<K>& key, VALUE* value) const {
+    EpochGuard guard;
+    const Table* table = current();
+    auto find_iter = table->find(key);
+    if (find_iter == table->end()) {
+      return false;
+    }
+    *value = find_iter->second;
+    return true;
+  }
+
+  size_t size() const {
+    EpochGuard guard;
+    return current()->size();
+  }
+
+  bool empty() const { return size() == 0; }
+
+  /**
+   * @brief Get the snapshot for many lookups against the same version.
+   *
+   * @return Snapshot The current version.
+   */
+  Snapshot snapshot() const { return Snapshot(*this); }
+
+  /**
+   * @brief Publish a new version updated by func(Table& table) on the copy of
+   * the current version.
+   */
+  template <typename FUNC>
+  void update(FUNC&& func) {
+    absl::MutexLock lock(&_write_mutex);
+    Table* next = new Table(*_current.load());
+    func(*next);
+    publish(next);
+  }
+
+  /**
+   * @brief Apply the batch updates and publish the new version.
+   *
+   * @param batch The updates.
+   */
+  void commit(Batch&& batch) {
+    if (batch.empty()) {
+      return;
+    }
+    update([&batch](Table& table) {
+      for (auto& update : batch._updates) {
+        if (update.second) {
+          table.insert_or_assign(std::move(update.first),
+                                 std::move(*update.second));
+        } else {
+          table.erase(update.first);
+        }
+      }
+    });
+    batch.clear();
+  }
+
+  /**
+   * @brief Publish the table as the new version.
+   *
+   * @param table The new content.
+   */
+  void reset(Table&& table) {
+    absl::MutexLock lock(&_write_mutex);
+    publish(new Table(std::move(table)));
+  }
+
+  /**
+   * @brief Insert or assign one element, it copies the whole table, so prefer
+   * the Batch for many updates.
+   */
+  void insert(const KEY& key, const VALUE& value) {
+    update([&key, &value](Table& table) {
+      table.insert_or_assign(key, value);
+    });
+  }
+
+  void erase(const KEY& key) {
+    update([&key](Table& table) { table.erase(key); });
+  }
+
+  /**
+   * @brief Free the retired versions which no reader can hold, it is also
+   * called by every publish.
+   */
+  void reclaim() {
+    absl::MutexLock lock(&_write_mutex);
+    reclaimLocked();
+  }
+
+  size_t numRetired() const {
+    absl::MutexLock lock(&_write_mutex);
+    return _retired.size();
+  }
+
+ private:
+  const Table* current() const { return _current.load(); }
+
+  void publish(const Table* next) {
+    const Table* old = _current.exchange(next);
+    _retired.emplace_back(old, EpochDomain::instance().advance());
+    reclaimLocked();
+  }
+
+  void reclaimLocked() {
+    if (_retired.empty()) {
+      return;
+    }
+    uint64_t min_epoch = EpochDomain::instance().minActiveEpoch();
+    size_t num_kept = 0;
+    for (auto& retired : _retired) {
+      if (retired.second <= min_epoch) {
+        delete retired.first;
+      } else {
+        _retired[num_kept++] = retired;
+      }
+    }
+    _retired.resize(num_kept);
+  }
+
+  // The table pointer is read by all readers, keep it away from the writer
+  // state.
+  alignas(64) std::atomic<const Table*> _current;
+  alignas(64) mutable absl::Mutex _write_mutex;
+  std::vector<std::pair<const Table*, uint64_t>> _retired;
+};
+
+}  // namespace pcl
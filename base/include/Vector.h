@@ -10,15 +10,40 @@
  */
 #pragma once
 #include <algorithm>
+#include <cstddef>
+#include <iterator>
 #include <memory>
+#include <utility>
+#include <vector>
 
+#include "SimdSearch.h"
 #include "absl/container/inlined_vector.h"
+#include "absl/types/span.h"
 
 namespace pcl {
-template <typename T, typename A = std::allocator<T>>
-class Vector : public absl::InlinedVector<T, /* N= */ 256, A> {
+
+/**
+ * @brief The default inline capacity of the Vector, the inline elements take
+ * at most 56 bytes, so sizeof(Vector<T>) is 64 bytes, one cache line, for the
+ * small T, and one element is inline for the large T.
+ */
+template <typename T>
+constexpr size_t kVectorInlineSize = sizeof(T) >= 56 ? 1 : 56 / sizeof(T);
+
+namespace detail {
+
+/**
+ * @brief The Vector API over the std like vector BASE, which is the
+ * InlinedVector of the Vector or the std::vector of the HeapVector.
+ *
+ * @tparam T
+ * @tparam N The inline capacity of BASE, zero for the heap only BASE.
+ * @tparam BASE
+ */
+template <typename T, size_t N, typename BASE>
+class VectorBase : public BASE {
  public:
-  using Base = typename Vector::InlinedVector;
+  using Base = BASE;
   using iterator = typename Base::iterator;
   using const_iterator = typename Base::const_iterator;
   using pointer = typename Base::pointer;
@@ -59,18 +84,38 @@ class Vector : public absl::InlinedVector<T, /* N= */ 256, A> {
   using Base::swap;  // Swaps the contents of the Vector with the other
                      // Vector,for exampla:vector1.swap(vector2)
 
+  static constexpr size_t kInlineSize = N;
+
+  /**
+   * @brief Whether the elements are stored in the heap, otherwise they are in
+   * the inline storage of the vector object.
+   */
+  bool isHeapAllocated() const { return this->capacity() > N; }
+
+  /**
+   * @brief The bytes of the vector object and its heap storage.
+   *
+   * @return size_t
+   */
+  size_t memoryBytes() const {
+    return sizeof(*this) +
+           (isHeapAllocated() ? this->capacity() * sizeof(T) : 0);
+  }
+
   /**
    * @brief Returns true if the vector contains an occurrence of value;
    *  otherwise returns false.
    *
+   * The arithmetic and pointer elements are scanned by the simd kernel, see
+   * SimdSearch.h, the others by the scalar loop.
+   *
    * @param value
    * @return true
    * @return false
    */
-  bool contains(const T& value) {
-    const_iterator b = this->begin();
-    const_iterator e = this->end();
-    return std::find(b, e, value) != e;
+  bool contains(const T& value) const {
+    const T* last = this->data() + this->size();
+    return simdFind(this->data(), last, value) != last;
   }
   /**
    * @brief Returns the number of occurrences of value in the vector.
@@ -78,10 +123,9 @@ class Vector : public absl::InlinedVector<T, /* N= */ 256, A> {
    * @param value
    * @return int
    */
-  int count(const T& value) {
-    const_iterator b = this->begin();
-    const_iterator e = this->end();
-    return static_cast<int>((std::count(b, e, value)));
+  int count(const T& value) const {
+    return static_cast<int>(
+        simdCount(this->data(), this->data() + this->size(), value));
   }
   /**
    * @brief Returns the index positon of the begin occurrence of the value valu
@@ -89,60 +133,79 @@ class Vector : public absl::InlinedVector<T, /* N= */ 256, A> {
    *
    * @param value
    * @param start
-   * @return int
+   * @return int The index, -1 if not found.
    */
-  int indexOf(const T& value, size_t start) {
+  int indexOf(const T& value, size_t start = 0) const {
     size_t size = this->size();
-    if (start < 0) start = std::max((size_t)0, start + size);
-    if (start < size) {
-      const_iterator n = this->begin() + start - 1;
-      const_iterator e = this->end();
-      while (++n != e) {
-        if (*n == value) return n - this->begin();
-      }
+    if (start >= size) {
+      return -1;
     }
-    return -1;
+    const T* first = this->data();
+    const T* found = simdFind(first + start, first + size, value);
+    return found == first + size ? -1 : static_cast<int>(found - first);
   }
   /**
    * @brief Returns the index position of the end occurrence of value in the
    * vector, searching backward from index position start.
    *
    * @param value
-   * @param start
-   * @return int
+   * @param start The negative start counts from the end, -1 is the last
+   * element.
+   * @return int The index, -1 if not found.
    */
-  int endIndexOf(const T& value, int start) {
-    size_t size = this->size();
-    if (start < 0)
+  int endIndexOf(const T& value, int start = -1) const {
+    int size = static_cast<int>(this->size());
+    if (start < 0) {
       start += size;
-    else if (start >= size)
+    } else if (start >= size) {
       start = size - 1;
-    if (start > 0) {
-      const_iterator b = this->begin();
-      const_iterator n = this->begin() + start + 1;
-      while (n != b) {
-        if (*--n == value) return n - b;
-      }
     }
-    return -1;
+    if (start < 0) {
+      return -1;
+    }
+    const T* first = this->data();
+    const T* found = simdFindLast(first, first + start + 1, value);
+    return found == first + start + 1 ? -1 : static_cast<int>(found - first);
   }
   /**
    * @brief Returns a vector whose elements are copied from this vector,starting
-   * at position pos, len elements are copied.
+   * at position pos, len elements are copied, or the elements to the end if
+   * there are less.The elements are moved instead if this vector is the
+   * temporary, e.g. std::move(vec).mid(pos, len).
    *
    * @param pos
    * @param len
-   * @return Vector<T>&
+   * @return VectorBase The new vector.
    */
-  Vector<T, A>& mid(size_t pos, size_t len) {
-    Vector<T>* midVector = new Vector<T, A>();
-    const_iterator from = this->begin() + pos;
-    const_iterator to = this->begin() + pos + len;
-    for (from; from != to; ++from) {
-      midVector->push_back(*from);
-    }
+  VectorBase mid(size_t pos, size_t len) const& {
+    auto range = slice(pos, len);
+    return VectorBase(range.begin(), range.end());
+  }
+  VectorBase mid(size_t pos, size_t len) && {
+    auto range = slice(pos, len);
+    return VectorBase(std::make_move_iterator(range.begin()),
+                      std::make_move_iterator(range.end()));
+  }
 
-    return *midVector;
+  /**
+   * @brief Returns the view of the len elements starting at position pos, or
+   * the elements to the end if there are less, nothing is copied.The view is
+   * valid until the vector is resized.
+   *
+   * @param pos
+   * @param len
+   * @return absl::Span<T> The view, the elements can be modified through it.
+   */
+  absl::Span<T> slice(size_t pos, size_t len = absl::Span<T>::npos) {
+    pos = std::min(pos, this->size());
+    return absl::Span<T>(this->data() + pos,
+                         std::min(len, this->size() - pos));
+  }
+  absl::Span<const T> slice(size_t pos,
+                            size_t len = absl::Span<T>::npos) const {
+    pos = std::min(pos, this->size());
+    return absl::Span<const T>(this->data() + pos,
+                               std::min(len, this->size() - pos));
   }
 
   /**
@@ -151,7 +214,7 @@ class Vector : public absl::InlinedVector<T, /* N= */ 256, A> {
    * @param value
    * @return Vector<T>&
    */
-  Vector<T>& operator+=(const T& value) {
+  VectorBase& operator+=(const T& value) {
     push_back(value);
     return *this;
   }
@@ -159,23 +222,32 @@ class Vector : public absl::InlinedVector<T, /* N= */ 256, A> {
    * @brief Returns a vector that contains all the items in vector val1
    * followed by all the items in the vector val2.
    *
+   * The storage is reserved once, and the temporary operand is reused, so
+   * a + b + c copies a and b once, and std::move(a) + b only appends b.
+   *
    * @param val1
    * @param val2
-   * @return Vector<T>&
+   * @return VectorBase The new vector.
    */
-  friend Vector<T, A>& operator+(const Vector<T, A>& val1,
-                                 const Vector<T, A>& val2) {
-    Vector<T>* ret_val = new Vector<T>;
-
-    for (Vector<T, A>::const_iterator it1 = val1.begin(); it1 != val1.end();
-         it1++) {
-      ret_val->push_back(*it1);
-    }
-    for (Vector<T, A>::const_iterator it2 = val2.begin(); it2 != val2.end();
-         it2++) {
-      ret_val->push_back(*it2);
-    }
-    return *ret_val;
+  friend VectorBase operator+(const VectorBase& val1, const VectorBase& val2) {
+    VectorBase ret_val;
+    ret_val.reserve(val1.size() + val2.size());
+    ret_val.insert(ret_val.end(), val1.begin(), val1.end());
+    ret_val.insert(ret_val.end(), val2.begin(), val2.end());
+    return ret_val;
+  }
+  friend VectorBase operator+(VectorBase&& val1, const VectorBase& val2) {
+    val1.insert(val1.end(), val2.begin(), val2.end());
+    return std::move(val1);
+  }
+  friend VectorBase operator+(const VectorBase& val1, VectorBase&& val2) {
+    val2.insert(val2.begin(), val1.begin(), val1.end());
+    return std::move(val2);
+  }
+  friend VectorBase operator+(VectorBase&& val1, VectorBase&& val2) {
+    val1.insert(val1.end(), std::make_move_iterator(val2.begin()),
+                std::make_move_iterator(val2.end()));
+    return std::move(val1);
   }
   /**
    * @brief Returns the vector val1 followed by all the items in the vector
@@ -193,21 +265,61 @@ class Vector : public absl::InlinedVector<T, /* N= */ 256, A> {
   const_reference operator[](size_t i) const { return data()[i]; }
   reference operator[](size_t i) { return data()[i]; }
 
-  friend bool operator<(const Vector<T, A>& a, const Vector<T, A>& b) {
+  friend bool operator<(const VectorBase& a, const VectorBase& b) {
     auto a_data = a.data();
     auto b_data = b.data();
     return std::lexicographical_compare(a_data, a_data + a.size(), b_data,
                                         b_data + b.size());
   }
 
-  friend bool operator>(const Vector<T, A>& a, const Vector<T, A>& b) {
+  friend bool operator>(const VectorBase& a, const VectorBase& b) {
     return b < a;
   }
-  friend bool operator<=(const Vector<T, A>& a, const Vector<T, A>& b) {
+  friend bool operator<=(const VectorBase& a, const VectorBase& b) {
     return !(b < a);
   }
-  friend bool operator>=(const Vector<T, A>& a, const Vector<T, A>& b) {
+  friend bool operator>=(const VectorBase& a, const VectorBase& b) {
     return !(a < b);
   }
 };
+
+}  // namespace detail
+
+/**
+ * @brief The vector with the inline storage of N elements, the elements are
+ * moved to the heap when the size exceeds N.
+ *
+ * The default N is small, the large N makes every vector object large even if
+ * it is empty, and the copy or move of the vector copies the inline elements,
+ * so choose the N by the usual size, e.g. VectorN<Pin*, 4> for the pins of the
+ * net, and use the HeapVector for the vector stored in the large arrays.
+ *
+ * @tparam T
+ * @tparam N The inline capacity.
+ * @tparam A
+ */
+template <typename T, size_t N, typename A = std::allocator<T>>
+using VectorN = detail::VectorBase<T, N, absl::InlinedVector<T, N, A>>;
+
+/**
+ * @brief The vector with the default inline capacity, the allocator stays the
+ * second template parameter as before, use the VectorN to choose the inline
+ * capacity.
+ *
+ * @tparam T
+ * @tparam A
+ */
+template <typename T, typename A = std::allocator<T>>
+using Vector = VectorN<T, kVectorInlineSize<T>, A>;
+
+/**
+ * @brief The vector without the inline storage, it is the size of three
+ * pointers and the move only swaps the pointers.
+ *
+ * @tparam T
+ * @tparam A
+ */
+template <typename T, typename A = std::allocator<T>>
+using HeapVector = detail::VectorBase<T, 0, std::vector<T, A>>;
+
 }  // namespace pcl
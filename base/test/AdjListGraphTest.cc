@@ -18,4 +18,113 @@ TEST(AdjGraphTest, test) {
   graph.insertEdge(2, 5, 5);
   graph.printAdjVector();
   graph.deleteEdge(2, 5);
-}
\ No newline at end of file
+}
+
+TEST(AdjGraphTest, breakCycles) {
+  Graph graph(6);
+  // cycle 0->1->2->0 and cycle 3->4->3, self loop 5->5.
+  graph.insertEdge(0, 1, 1);
+  graph.insertEdge(1, 2, 1);
+  graph.insertEdge(2, 0, 1);
+  graph.insertEdge(2, 3, 1);
+  graph.insertEdge(3, 4, 1);
+  graph.insertEdge(4, 3, 1);
+  graph.insertEdge(4, 5, 1);
+  graph.insertEdge(5, 5, 1);
+
+  pcl::Vector<int> order;
+  EXPECT_FALSE(graph.topologicalOrder(&order));
+
+  int num_disabled = graph.breakCycles();
+  EXPECT_EQ(num_disabled, 3);
+  EXPECT_EQ(graph.getNumDisabledEdge(), 3);
+  EXPECT_EQ(graph.getNumEdge(), 8);
+  EXPECT_TRUE(graph.topologicalOrder(&order));
+  EXPECT_EQ(order.size(), 6);
+
+  // The edges between the components are kept.
+  graph.enableAllEdges();
+  graph.setEdgeDisabled(2, 3, true);
+  EXPECT_EQ(graph.getNumDisabledEdge(), 1);
+  graph.breakCycles();
+  EXPECT_TRUE(graph.topologicalOrder(&order));
+}
+
+TEST(AdjGraphTest, breakCyclesDag) {
+  Graph graph(4);
+  graph.insertEdge(0, 1, 1);
+  graph.insertEdge(1, 2, 1);
+  graph.insertEdge(0, 3, 1);
+  EXPECT_EQ(graph.breakCycles(), 0);
+  pcl::Vector<int> order;
+  EXPECT_TRUE(graph.topologicalOrder(&order));
+  EXPECT_EQ(order[0], 0);
+}
+
+TEST(AdjGraphTest, insertEdges) {
+  pcl::Vector<pcl::GraphEdge> edges{{0, 2, 1}, {0, 1, 2}, {0, 2, 3}, {1, 2, 4}};
+  Graph graph(3);
+  graph.insertEdge(0, 2, 9);
+  graph.insertEdges(edges);
+  EXPECT_EQ(graph.getNumEdge(), 3);
+  pcl::Vector<int> order;
+  EXPECT_TRUE(graph.topologicalOrder(&order));
+  EXPECT_EQ(order[0], 0);
+  EXPECT_EQ(order[1], 1);
+  EXPECT_EQ(order[2], 2);
+}
+
+TEST(AdjGraphTest, traverse) {
+  Graph graph(6);
+  graph.insertEdge(0, 1, 4);
+  graph.insertEdge(0, 2, 1);
+  graph.insertEdge(2, 1, 2);
+  graph.insertEdge(1, 3, 5);
+  graph.insertEdge(4, 5, 1);
+
+  pcl::Vector<int> order;
+  graph.bfsOrder(0, &order);
+  EXPECT_EQ(order.size(), 4);
+  EXPECT_EQ(order[0], 0);
+  EXPECT_EQ(order[3], 3);
+
+  graph.dfsOrder(0, &order);
+  EXPECT_EQ(order.size(), 4);
+  EXPECT_EQ(order[0], 0);
+
+  pcl::Vector<int64_t> dist;
+  graph.shortestPath(0, &dist);
+  EXPECT_EQ(dist[1], 3);
+  EXPECT_EQ(dist[3], 8);
+  EXPECT_EQ(dist[4], Graph::kUnreachable);
+
+  // The disabled edge is skipped.
+  graph.setEdgeDisabled(2, 1, true);
+  graph.shortestPath(0, &dist);
+  EXPECT_EQ(dist[1], 4);
+}
+
+TEST(AdjGraphTest, components) {
+  Graph graph(7);
+  graph.insertEdge(0, 1, 1);
+  graph.insertEdge(1, 2, 1);
+  graph.insertEdge(2, 0, 1);
+  graph.insertEdge(2, 3, 1);
+  graph.insertEdge(5, 4, 1);
+
+  pcl::Vector<int> component;
+  EXPECT_EQ(graph.connectedComponents(&component), 3);
+  EXPECT_EQ(component[3], component[0]);
+  EXPECT_EQ(component[4], component[5]);
+  EXPECT_NE(component[6], component[0]);
+
+  pcl::Vector<int> component1;
+  EXPECT_EQ(graph.connectedComponents(&component1, 4), 3);
+  EXPECT_TRUE(component == component1);
+
+  EXPECT_EQ(graph.stronglyConnectedComponents(&component), 5);
+  EXPECT_EQ(component[0], component[1]);
+  EXPECT_EQ(component[1], component[2]);
+  EXPECT_NE(component[3], component[0]);
+  EXPECT_NE(component[4], component[5]);
+}
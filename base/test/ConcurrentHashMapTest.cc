@@ -0,0 +1,78 @@
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ConcurrentHashMap.h"
+#include "gtest/gtest.h"
+
+using pcl::ConcurrentHashMap;
+
+namespace {
+
+TEST(ConcurrentHashMapTest, basic) {
+  ConcurrentHashMap<std::string, int> hmap(5);
+  EXPECT_EQ(hmap.numShards(), 8);
+  EXPECT_TRUE(hmap.empty());
+
+  EXPECT_TRUE(hmap.insert("a", 1));
+  EXPECT_FALSE(hmap.insert("a", 2));
+  EXPECT_EQ(hmap.value("a"), 1);
+  EXPECT_FALSE(hmap.upsert("a", 3));
+  EXPECT_EQ(hmap.value("a"), 3);
+  EXPECT_TRUE(hmap.upsert("b", 4));
+
+  int value = 0;
+  EXPECT_TRUE(hmap.find("b", &value));
+  EXPECT_EQ(value, 4);
+  EXPECT_FALSE(hmap.find("c", &value));
+  EXPECT_TRUE(hmap.hasKey("b"));
+  EXPECT_FALSE(hmap.hasKey("c"));
+  EXPECT_EQ(hmap.value("c", -1), -1);
+
+  EXPECT_TRUE(hmap.compute("c", [](int& v, bool inserted) {
+    EXPECT_TRUE(inserted);
+    v = 5;
+  }));
+  EXPECT_TRUE(hmap.computeIfPresent("c", [](int& v) { v *= 2; }));
+  EXPECT_FALSE(hmap.computeIfPresent("d", [](int& v) { v *= 2; }));
+  EXPECT_EQ(hmap.value("c"), 10);
+  EXPECT_EQ(hmap.size(), 3);
+
+  int sum = 0;
+  hmap.forEach([&sum](const std::string&, int v) { sum += v; });
+  EXPECT_EQ(sum, 17);
+
+  EXPECT_TRUE(hmap.erase("a"));
+  EXPECT_FALSE(hmap.erase("a"));
+  hmap.clear();
+  EXPECT_TRUE(hmap.empty());
+}
+
+TEST(ConcurrentHashMapTest, concurrent) {
+  ConcurrentHashMap<int, int> hmap;
+  hmap.reserve(1000);
+  const int num_threads = 8;
+  const int num_keys = 1000;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; ++t) {
+    threads.emplace_back([&hmap, t]() {
+      for (int i = 0; i < num_keys; ++i) {
+        hmap.compute(i, [](int& count, bool) { ++count; });
+        hmap.insert(num_keys + t * num_keys + i, i);
+        int value = 0;
+        hmap.find(i, &value);
+        EXPECT_GE(value, 1);
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  EXPECT_EQ(hmap.size(), num_keys * (num_threads + 1));
+  for (int i = 0; i < num_keys; ++i) {
+    ASSERT_EQ(hmap.value(i), num_threads);
+  }
+}
+
+}  // namespace
@@ -0,0 +1,75 @@
+#include <sstream>
+#include <string>
+
+#include "ContainerStats.h"
+#include "HashMap.h"
+#include "HashSet.h"
+#include "gtest/gtest.h"
+
+using pcl::ContainerStats;
+using pcl::HashMap;
+using pcl::HashSet;
+using pcl::HashTableStats;
+
+namespace {
+
+struct BadHash {
+  size_t operator()(int) const { return 0; }
+};
+
+TEST(ContainerStatsTest, scan) {
+  HashMap<int, int> hmap;
+  for (int i = 0; i < 1000; ++i) {
+    hmap[i] = i;
+  }
+  HashTableStats stats = hmap.stats("hmap");
+  EXPECT_EQ(stats.site, "hmap");
+  EXPECT_EQ(stats.size, 1000);
+  EXPECT_EQ(stats.capacity, hmap.bucket_count());
+  EXPECT_LT(stats.meanProbeLength(), 1.0);
+
+  HashSet<int, BadHash> bad_set;
+  for (int i = 0; i < 200; ++i) {
+    bad_set.insert(i);
+  }
+  stats = bad_set.stats();
+  EXPECT_EQ(stats.size, 200);
+  EXPECT_GT(stats.max_probe_length, 4);
+
+  // The erased keys are not scanned.
+  for (int i = 0; i < 200; i += 2) {
+    bad_set.erase(i);
+  }
+  stats = bad_set.stats();
+  EXPECT_EQ(stats.size, 100);
+  EXPECT_GT(stats.max_probe_length, 4);
+}
+
+TEST(ContainerStatsTest, report) {
+  HashSet<int, BadHash> bad_set = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10,
+                                   11, 12, 13, 14, 15, 16, 17, 18, 19, 20};
+  HashSet<int> good_set = {1, 2, 3};
+
+  ContainerStats& container_stats = ContainerStats::instance();
+  ContainerStats::Tracker good_tracker =
+      container_stats.track("good_set", &good_set);
+  {
+    ContainerStats::Tracker bad_tracker =
+        container_stats.track("bad_set", &bad_set);
+    auto all_stats = container_stats.collect();
+    ASSERT_EQ(all_stats.size(), 2);
+    // The worst probed table comes first.
+    EXPECT_EQ(all_stats[0].site, "bad_set");
+    EXPECT_EQ(all_stats[1].site, "good_set");
+
+    std::ostringstream out;
+    container_stats.dump(out);
+    EXPECT_NE(out.str().find("bad_set"), std::string::npos);
+  }
+  auto all_stats = container_stats.collect();
+  ASSERT_EQ(all_stats.size(), 1);
+  EXPECT_EQ(all_stats[0].site, "good_set");
+  EXPECT_EQ(all_stats[0].size, 3);
+}
+
+}  // namespace
@@ -0,0 +1,157 @@
+#include <set>
+#include <string>
+#include <vector>
+
+#include "DenseIdSet.h"
+#include "gtest/gtest.h"
+
+using pcl::DenseIdMap;
+using pcl::DenseIdSet;
+
+namespace {
+
+TEST(DenseIdSetTest, insert) {
+  DenseIdSet<int> ids;
+  EXPECT_TRUE(ids.empty());
+  EXPECT_TRUE(ids.insert(3));
+  EXPECT_FALSE(ids.insert(3));
+  EXPECT_TRUE(ids.insert(200));
+  EXPECT_EQ(ids.size(), 2);
+  EXPECT_GE(ids.capacity(), 201);
+  EXPECT_TRUE(ids.hasKey(3));
+  EXPECT_TRUE(ids.contains(200));
+  EXPECT_FALSE(ids.contains(4));
+  EXPECT_FALSE(ids.contains(100000));
+  EXPECT_FALSE(ids.contains(-1));
+  EXPECT_EQ(ids.count(200), 1);
+
+  // The negative id is rejected instead of wrapping to a huge index.
+  EXPECT_FALSE(ids.insert(-1));
+  EXPECT_EQ(ids.size(), 2);
+  EXPECT_FALSE(ids.contains(-1));
+
+  EXPECT_EQ(ids.erase(3), 1);
+  EXPECT_EQ(ids.erase(3), 0);
+  EXPECT_EQ(ids.erase(100000), 0);
+  EXPECT_EQ(ids.size(), 1);
+}
+
+TEST(DenseIdSetTest, iterate) {
+  DenseIdSet<int> ids = {130, 0, 63, 64, 5, 1000};
+  std::vector<int> expect = {0, 5, 63, 64, 130, 1000};
+  std::vector<int> result(ids.begin(), ids.end());
+  EXPECT_EQ(result, expect);
+
+  result.clear();
+  ids.forEach([&result](int id) { result.push_back(id); });
+  EXPECT_EQ(result, expect);
+
+  DenseIdSet<int> empty(1000);
+  EXPECT_TRUE(empty.begin() == empty.end());
+}
+
+TEST(DenseIdSetTest, algebra) {
+  DenseIdSet<int> a;
+  DenseIdSet<int> b;
+  std::set<int> sa;
+  std::set<int> sb;
+  for (int i = 0; i < 3000; i += 3) {
+    a.insert(i);
+    sa.insert(i);
+  }
+  for (int i = 0; i < 1000; i += 5) {
+    b.insert(i);
+    sb.insert(i);
+  }
+
+  auto expect = [](const std::set<int>& s) {
+    return std::vector<int>(s.begin(), s.end());
+  };
+  auto result = [](const DenseIdSet<int>& s) {
+    return std::vector<int>(s.begin(), s.end());
+  };
+
+  std::set<int> s_union = sa;
+  s_union.insert(sb.begin(), sb.end());
+  std::set<int> s_intersect;
+  std::set<int> s_subtract;
+  for (int i : sa) {
+    (sb.count(i) ? s_intersect : s_subtract).insert(i);
+  }
+
+  DenseIdSet<int> u = b | a;
+  EXPECT_EQ(result(u), expect(s_union));
+  EXPECT_EQ(u.size(), s_union.size());
+
+  DenseIdSet<int> in = a & b;
+  EXPECT_EQ(result(in), expect(s_intersect));
+  EXPECT_EQ(in.size(), s_intersect.size());
+  EXPECT_EQ(a.intersectCount(b), s_intersect.size());
+  EXPECT_EQ((b & a), in);
+
+  DenseIdSet<int> sub = a - b;
+  EXPECT_EQ(result(sub), expect(s_subtract));
+  EXPECT_EQ(sub.size(), s_subtract.size());
+
+  EXPECT_TRUE(in.isSubset(a));
+  EXPECT_TRUE(in.isSubset(b));
+  EXPECT_FALSE(a.isSubset(b));
+  EXPECT_TRUE(a.intersects(b));
+  EXPECT_FALSE(sub.intersects(b));
+
+  DenseIdSet<int> c = a;
+  c.unite(b).subtract(b).intersect(a);
+  EXPECT_EQ(c, sub);
+  c |= 1;
+  c -= 1;
+  EXPECT_EQ(c, sub);
+  EXPECT_NE(c, a);
+
+  // The size is kept over the words of the small other set only.
+  DenseIdSet<int> big = a;
+  DenseIdSet<int> small = {0, 1, 3, 64, 65};
+  big.unite(small);
+  EXPECT_EQ(big.size(), sa.size() + 3);
+  big.subtract(small);
+  EXPECT_EQ(big.size(), sa.size() - 2);
+  EXPECT_EQ(big.count(2997), 1);
+  big.intersect(small);
+  EXPECT_TRUE(big.empty());
+}
+
+TEST(DenseIdMapTest, basic) {
+  DenseIdMap<std::string> names;
+  names.insert(7, "u7");
+  names[2] = "u2";
+  names.insert(7, "u7_new");
+  names[500] = "u500";
+  EXPECT_EQ(names.size(), 3);
+  EXPECT_TRUE(names.hasKey(2));
+  EXPECT_FALSE(names.contains(3));
+  EXPECT_EQ(names.value(7), "u7_new");
+  EXPECT_EQ(names.value(3, "none"), "none");
+  EXPECT_EQ(*names.find(500), "u500");
+  EXPECT_EQ(names.find(501), nullptr);
+
+  std::vector<int> ids;
+  std::vector<std::string> values;
+  for (auto kv : names) {
+    ids.push_back(kv.first);
+    values.push_back(kv.second);
+  }
+  EXPECT_EQ(ids, std::vector<int>({2, 7, 500}));
+  EXPECT_EQ(values, std::vector<std::string>({"u2", "u7_new", "u500"}));
+
+  names.forEach([](int, std::string& value) { value += "!"; });
+  EXPECT_EQ(names.value(2), "u2!");
+
+  EXPECT_EQ(names.erase(7), 1);
+  EXPECT_EQ(names.erase(7), 0);
+  EXPECT_EQ(names.size(), 2);
+  EXPECT_EQ(names.value(7), "");
+
+  DenseIdSet<int> expect_keys = {2, 500};
+  EXPECT_EQ(names.keys(), expect_keys);
+}
+
+}  // namespace
@@ -0,0 +1,67 @@
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "FlatMap.h"
+#include "gtest/gtest.h"
+
+using pcl::FlatMap;
+
+namespace {
+
+TEST(FlatMapTest, bulkLoad) {
+  std::vector<std::pair<int, std::string>> items = {
+      {3, "c"}, {1, "a"}, {2, "b"}, {1, "x"}};
+  FlatMap<int, std::string> fmap(items.begin(), items.end());
+  EXPECT_EQ(fmap.size(), 3);
+  // The first item of the equal keys is kept as the Map.
+  EXPECT_EQ(fmap.value(1), "a");
+  EXPECT_EQ(fmap.value(4, "none"), "none");
+  EXPECT_TRUE(fmap.hasKey(2));
+  EXPECT_FALSE(fmap.hasKey(4));
+
+  std::vector<int> keys;
+  for (int key : fmap.keysView()) {
+    keys.push_back(key);
+  }
+  EXPECT_EQ(keys, std::vector<int>({1, 2, 3}));
+  auto values = fmap.values();
+  EXPECT_EQ(values.front(), "a");
+  EXPECT_EQ(values.back(), "c");
+  EXPECT_EQ(fmap.keys().size(), 3);
+}
+
+TEST(FlatMapTest, modify) {
+  FlatMap<std::string, int> fmap = {{"b", 2}, {"d", 4}};
+  fmap.insert("a", 1);
+  fmap.insert(std::string("c"), 3);
+  fmap.insert("a", 10);
+  fmap["e"] = 5;
+  fmap["b"] += 20;
+  EXPECT_EQ(fmap.size(), 5);
+  EXPECT_EQ(fmap.value("a"), 10);
+  EXPECT_EQ(fmap.value("b"), 22);
+
+  auto iter = fmap.lower_bound("bb");
+  ASSERT_NE(iter, fmap.end());
+  EXPECT_EQ(iter->first, "c");
+  iter = fmap.upper_bound("c");
+  EXPECT_EQ(iter->first, "d");
+
+  for (auto& value : fmap.valuesView()) {
+    value *= 2;
+  }
+  EXPECT_EQ(fmap.value("e"), 10);
+
+  EXPECT_EQ(fmap.erase("c"), 1);
+  EXPECT_EQ(fmap.erase("c"), 0);
+  EXPECT_EQ(fmap.find("c"), fmap.end());
+  EXPECT_EQ(fmap.size(), 4);
+
+  FlatMap<std::string, int> other = fmap;
+  EXPECT_EQ(other, fmap);
+  other["z"] = 0;
+  EXPECT_NE(other, fmap);
+}
+
+}  // namespace
@@ -0,0 +1,69 @@
+#include <algorithm>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "FlatSet.h"
+#include "gtest/gtest.h"
+
+using pcl::FlatSet;
+
+namespace {
+
+TEST(FlatSetTest, bulkLoad) {
+  FlatSet<int> fset = {5, 1, 3, 1, 9, 3};
+  std::vector<int> keys(fset.begin(), fset.end());
+  EXPECT_EQ(keys, std::vector<int>({1, 3, 5, 9}));
+  EXPECT_TRUE(fset.hasKey(5));
+  EXPECT_FALSE(fset.contains(4));
+
+  std::vector<int> more = {4, 9, 0};
+  fset.insert(more.begin(), more.end());
+  keys.assign(fset.begin(), fset.end());
+  EXPECT_EQ(keys, std::vector<int>({0, 1, 3, 4, 5, 9}));
+
+  EXPECT_TRUE(fset.insert(2).second);
+  EXPECT_FALSE(fset.insert(2).second);
+  EXPECT_EQ(fset.erase(3), 1);
+  EXPECT_EQ(fset.erase(3), 0);
+  keys.assign(fset.begin(), fset.end());
+  EXPECT_EQ(keys, std::vector<int>({0, 1, 2, 4, 5, 9}));
+}
+
+TEST(FlatSetTest, search) {
+  std::mt19937 gen(7);
+  std::vector<int> values;
+  for (int i = 0; i < 5000; ++i) {
+    values.push_back(gen() % 20000);
+  }
+  FlatSet<int> fset(values.begin(), values.end());
+  std::set<int> expect(values.begin(), values.end());
+  EXPECT_EQ(fset.size(), expect.size());
+  for (int key = -1; key <= 20000; ++key) {
+    auto iter = fset.lower_bound(key);
+    auto expect_iter = expect.lower_bound(key);
+    ASSERT_EQ(iter == fset.end(), expect_iter == expect.end());
+    if (iter != fset.end()) {
+      EXPECT_EQ(*iter, *expect_iter);
+    }
+    auto upper = fset.upper_bound(key);
+    auto expect_upper = expect.upper_bound(key);
+    ASSERT_EQ(upper == fset.end(), expect_upper == expect.end());
+    if (upper != fset.end()) {
+      EXPECT_EQ(*upper, *expect_upper);
+    }
+    EXPECT_EQ(fset.count(key), expect.count(key));
+  }
+}
+
+TEST(FlatSetTest, algebra) {
+  FlatSet<int> set1 = {1, 2, 3, 4};
+  FlatSet<int> set2 = {3, 4, 5};
+  EXPECT_EQ(set1 | set2, FlatSet<int>({1, 2, 3, 4, 5}));
+  EXPECT_EQ(set1 & set2, FlatSet<int>({3, 4}));
+  EXPECT_EQ(set1 - set2, FlatSet<int>({1, 2}));
+  set1 -= set2;
+  EXPECT_EQ(set1, FlatSet<int>({1, 2}));
+}
+
+}  // namespace
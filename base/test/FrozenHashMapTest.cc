@@ -0,0 +1,102 @@
+#include <cstdio>
+#include <string>
+
+#include "FrozenHashMap.h"
+#include "HashMap.h"
+#include "gtest/gtest.h"
+
+using pcl::FrozenHashMap;
+using pcl::HashMap;
+using pcl::freeze;
+
+namespace {
+
+TEST(FrozenHashMapTest, integer) {
+  HashMap<int, int> hmap;
+  for (int i = 0; i < 100000; ++i) {
+    hmap[i * 7] = i;
+  }
+  auto frozen_map = freeze(hmap);
+  ASSERT_TRUE(frozen_map.has_value());
+  const auto& frozen = *frozen_map;
+  ASSERT_EQ(frozen.size(), hmap.size());
+  for (int i = 0; i < 100000; ++i) {
+    const int* value = frozen.find(i * 7);
+    ASSERT_TRUE(value != nullptr);
+    ASSERT_EQ(*value, i);
+  }
+  EXPECT_FALSE(frozen.hasKey(1));
+  EXPECT_EQ(frozen.value(-7, -1), -1);
+
+  // The displacement costs about one byte per key.
+  EXPECT_LT(frozen.memoryBytes(), hmap.size() * (2 * sizeof(int) + 2));
+
+  int sum = 0;
+  frozen.forEach([&sum](int key, int value) { sum += key / 7 - value; });
+  EXPECT_EQ(sum, 0);
+}
+
+TEST(FrozenHashMapTest, empty) {
+  HashMap<int, int> hmap;
+  auto frozen = freeze(hmap);
+  ASSERT_TRUE(frozen.has_value());
+  EXPECT_TRUE(frozen->empty());
+  EXPECT_FALSE(frozen->hasKey(0));
+
+  hmap[3] = 4;
+  frozen = freeze(hmap);
+  ASSERT_TRUE(frozen.has_value());
+  EXPECT_EQ(frozen->value(3), 4);
+}
+
+// All keys collide, the build fails at once instead of searching the seeds.
+struct CollideHash {
+  uint64_t operator()(int) const { return 1; }
+};
+
+TEST(FrozenHashMapTest, duplicateHash) {
+  HashMap<int, int> hmap = {{1, 1}, {2, 2}};
+  EXPECT_FALSE((freeze<HashMap<int, int>, CollideHash>(hmap).has_value()));
+
+  FrozenHashMap<int, int, CollideHash> frozen;
+  EXPECT_FALSE(frozen.build(hmap));
+  EXPECT_TRUE(frozen.empty());
+  EXPECT_FALSE(frozen.hasKey(1));
+
+  // The single key has no collision.
+  hmap.erase(2);
+  auto single = freeze<HashMap<int, int>, CollideHash>(hmap);
+  ASSERT_TRUE(single.has_value());
+  EXPECT_EQ(single->value(1), 1);
+}
+
+TEST(FrozenHashMapTest, saveLoad) {
+  HashMap<std::string, double> hmap;
+  for (int i = 0; i < 5000; ++i) {
+    hmap["cell_" + std::to_string(i)] = i * 0.5;
+  }
+  auto frozen_map = freeze(hmap);
+  ASSERT_TRUE(frozen_map.has_value());
+  const auto& frozen = *frozen_map;
+  EXPECT_EQ(frozen.value("cell_42"), 21.0);
+  EXPECT_FALSE(frozen.hasKey("cell_5000"));
+
+  std::string file_name = "frozen_hash_map_test.fhm";
+  ASSERT_TRUE(frozen.save(file_name.c_str()));
+
+  FrozenHashMap<std::string, double> loaded;
+  ASSERT_TRUE(loaded.load(file_name.c_str()));
+  ASSERT_EQ(loaded.size(), 5000);
+  for (const auto& p : hmap) {
+    ASSERT_EQ(loaded.value(p.first, -1.0), p.second);
+  }
+  EXPECT_FALSE(loaded.hasKey("cell"));
+
+  // The map of another type can not be loaded.
+  FrozenHashMap<std::string, int> wrong_type;
+  EXPECT_FALSE(wrong_type.load(file_name.c_str()));
+  EXPECT_FALSE(wrong_type.load("not_exist.fhm"));
+  std::remove(file_name.c_str());
+}
+
+}  // namespace
@@ -0,0 +1,92 @@
+#include <algorithm>
+
+#include "GraphGenerator.h"
+#include "gtest/gtest.h"
+
+using pcl::Graph;
+using pcl::GraphEdge;
+using pcl::GraphGenerator;
+using pcl::Vector;
+
+namespace {
+
+bool sameEdges(const Vector<GraphEdge>& edges1,
+               const Vector<GraphEdge>& edges2) {
+  return edges1.size() == edges2.size() &&
+         std::equal(edges1.begin(), edges1.end(), edges2.begin(),
+                    [](const GraphEdge& e1, const GraphEdge& e2) {
+                      return e1.tail == e2.tail && e1.head == e2.head &&
+                             e1.weight == e2.weight;
+                    });
+}
+
+TEST(GraphGeneratorTest, rmat) {
+  Vector<GraphEdge> edges;
+  GraphGenerator generator(7, 4);
+  generator.rmat(10, 200000, &edges);
+  ASSERT_EQ(edges.size(), 200000);
+  for (const auto& e : edges) {
+    ASSERT_TRUE(e.tail >= 0 && e.tail < 1024);
+    ASSERT_TRUE(e.head >= 0 && e.head < 1024);
+    ASSERT_TRUE(e.weight >= 1 && e.weight <= 100);
+  }
+
+  // The result does not depend on the thread number.
+  Vector<GraphEdge> edges1;
+  GraphGenerator generator1(7, 1);
+  generator1.rmat(10, 200000, &edges1);
+  EXPECT_TRUE(sameEdges(edges, edges1));
+
+  Vector<GraphEdge> edges2;
+  GraphGenerator generator2(8, 4);
+  generator2.rmat(10, 200000, &edges2);
+  EXPECT_FALSE(sameEdges(edges, edges2));
+}
+
+TEST(GraphGeneratorTest, layeredDag) {
+  Vector<GraphEdge> edges;
+  GraphGenerator generator(1, 3);
+  generator.layeredDag(20, 5000, 0.6, &edges);
+  EXPECT_GE(edges.size(), 19 * 5000);
+  for (const auto& e : edges) {
+    ASSERT_LT(e.tail / 5000, e.head / 5000);
+    ASSERT_LE(e.head / 5000 - e.tail / 5000, 2);
+  }
+
+  Vector<GraphEdge> edges1;
+  GraphGenerator generator1(1, 1);
+  generator1.layeredDag(20, 5000, 0.6, &edges1);
+  EXPECT_TRUE(sameEdges(edges, edges1));
+
+  Graph graph(20 * 5000);
+  graph.insertEdges(edges);
+  Vector<int> order;
+  EXPECT_TRUE(graph.topologicalOrder(&order));
+  EXPECT_LE(graph.getNumEdge(), static_cast<int>(edges.size()));
+}
+
+TEST(GraphGeneratorTest, hypergraph) {
+  Vector<int> net_offsets;
+  Vector<int> pins;
+  GraphGenerator generator(3, 2);
+  generator.hypergraph(1000, 100000, 0.6, &net_offsets, &pins, 32);
+  ASSERT_EQ(net_offsets.size(), 100001);
+  EXPECT_EQ(net_offsets.back(), pins.size());
+  for (size_t net = 0; net + 1 < net_offsets.size(); ++net) {
+    int degree = net_offsets[net + 1] - net_offsets[net];
+    ASSERT_TRUE(degree >= 2 && degree <= 32);
+    Vector<int> net_pins(pins.begin() + net_offsets[net],
+                         pins.begin() + net_offsets[net + 1]);
+    std::sort(net_pins.begin(), net_pins.end());
+    ASSERT_TRUE(std::adjacent_find(net_pins.begin(), net_pins.end()) ==
+                net_pins.end());
+  }
+
+  Vector<GraphEdge> edges;
+  GraphGenerator::hypergraphToEdges(net_offsets, pins, &edges);
+  EXPECT_EQ(edges.size(), pins.size() - 100000);
+  EXPECT_EQ(edges[0].tail, pins[0]);
+  EXPECT_EQ(edges[0].head, pins[1]);
+}
+
+}  // namespace
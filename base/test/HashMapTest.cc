@@ -1,10 +1,16 @@
 #include <algorithm>
 #include <functional>
 #include <iterator>
+#include <memory>
+#include <numeric>
 #include <random>
+#include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "HashMap.h"
+#include "absl/strings/string_view.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest-death-test.h"
 #include "gtest/gtest.h"
@@ -793,4 +799,81 @@ TEST(HashMapTest, perf4) {
   timeit(map_erase, "erase");
 }
 
+TEST(HashMapTest, findBatch) {
+  HashMap<int, int> hmap;
+  for (int i = 0; i < 1000; ++i) {
+    hmap[i * 2] = i;
+  }
+  std::vector<int> keys;
+  for (int i = 0; i < 100; ++i) {
+    keys.push_back(i);
+  }
+  std::vector<const int*> values(keys.size());
+  hmap.findBatch(keys.data(), keys.size(), values.data());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    if (keys[i] % 2 == 0) {
+      ASSERT_TRUE(values[i] != nullptr);
+      EXPECT_EQ(*values[i], keys[i] / 2);
+    } else {
+      EXPECT_TRUE(values[i] == nullptr);
+    }
+  }
+
+  std::unique_ptr<bool[]> found(new bool[keys.size()]);
+  EXPECT_EQ(hmap.containsBatch(keys.data(), keys.size(), found.get()), 50);
+  EXPECT_TRUE(found[98]);
+  EXPECT_FALSE(found[99]);
+}
+
+TEST(HashMapTest, keysView) {
+  HashMap<int, int> hmap = {{1, 10}, {2, 20}, {3, 30}};
+  auto keys = hmap.keysView();
+  EXPECT_EQ(keys.size(), 3);
+  int key_sum = 0;
+  for (const int& key : keys) {
+    key_sum += key;
+  }
+  EXPECT_EQ(key_sum, 6);
+
+  for (int& value : hmap.valuesView()) {
+    value += 1;
+  }
+  const auto& chmap = hmap;
+  auto values = chmap.valuesView();
+  EXPECT_EQ(std::accumulate(values.begin(), values.end(), 0), 63);
+
+  pcl::Vector<int> key_vec = {0};
+  hmap.keysInto(&key_vec);
+  EXPECT_EQ(key_vec.size(), 4);
+  pcl::Vector<int> value_vec;
+  hmap.valuesInto(&value_vec);
+  std::sort(value_vec.begin(), value_vec.end());
+  EXPECT_EQ(value_vec[2], 31);
+}
+
+TEST(HashMapTest, heterogeneous) {
+  HashMap<std::string, std::unique_ptr<int>> hmap;
+  hmap.insert("a", std::make_unique<int>(1));
+  std::string key = "b";
+  auto value = std::make_unique<int>(2);
+  hmap.insert(std::move(key), std::move(value));
+  EXPECT_EQ(value, nullptr);
+  hmap.insert(absl::string_view("a"), std::make_unique<int>(3));
+  EXPECT_EQ(hmap.size(), 2);
+  EXPECT_EQ(*hmap.find("a")->second, 3);
+
+  EXPECT_TRUE(hmap.hasKey(absl::string_view("b")));
+  EXPECT_TRUE(hmap.hasKey("a"));
+  EXPECT_FALSE(hmap.hasKey("c"));
+
+  HashMap<std::string, int> counts{{"x", 1}, {"y", 2}};
+  EXPECT_EQ(counts.value(absl::string_view("y")), 2);
+  EXPECT_EQ(counts.value("z", -1), -1);
+
+  HashMultimap<int, std::string> hmultimap;
+  hmultimap.insert(1, "one");
+  hmultimap.insert(1, std::string("uno"));
+  EXPECT_EQ(hmultimap.count(1), 2);
+}
+
 }  // namespace
@@ -2,6 +2,7 @@
 #include <functional>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "HashSet.h"
 #include "gtest/gtest.h"
@@ -528,4 +529,54 @@ TEST(HashSetTest, perf3) {
   timeit(set_erase, "erase");
 }
 
-}  // namespace
\ No newline at end of file
+TEST(HashSetTest, findBatch) {
+  HashSet<int> hset;
+  for (int i = 0; i < 1000; ++i) {
+    hset.insert(i * 3);
+  }
+  int keys[40];
+  for (int i = 0; i < 40; ++i) {
+    keys[i] = i;
+  }
+  const int* found[40];
+  hset.findBatch(keys, 40, found);
+  EXPECT_EQ(*found[39], 39);
+  EXPECT_TRUE(found[38] == nullptr);
+
+  bool contained[40];
+  EXPECT_EQ(hset.containsBatch(keys, 40, contained), 14);
+  EXPECT_TRUE(contained[0]);
+  EXPECT_FALSE(contained[1]);
+}
+TEST(HashSetTest, intersectAll) {
+  // The set i has the multiples of i + 2 in [0, 60000).
+  std::vector<HashSet<int>> sets(4);
+  for (int i = 0; i < 4; ++i) {
+    for (int k = 0; k < 60000; k += i + 2) {
+      sets[i].insert(k);
+    }
+  }
+  std::vector<const HashSet<int>*> set_ptrs = {&sets[0], &sets[1], &sets[2],
+                                               &sets[3]};
+  for (int num_threads : {1, 4}) {
+    HashSet<int> result = HashSet<int>::intersectAll(set_ptrs, num_threads);
+    EXPECT_EQ(result.size(), 1000);
+    EXPECT_TRUE(result.hasKey(0));
+    EXPECT_TRUE(result.hasKey(59940));
+    EXPECT_FALSE(result.hasKey(30));
+
+    result = HashSet<int>::uniteAll(set_ptrs);
+    HashSet<int> expect;
+    for (const auto& set : sets) {
+      expect.unite(set);
+    }
+    EXPECT_EQ(result, expect);
+  }
+
+  set_ptrs.push_back(nullptr);
+  EXPECT_TRUE(HashSet<int>::intersectAll(set_ptrs).empty());
+  EXPECT_EQ(HashSet<int>::uniteAll(set_ptrs).size(), 44000);
+  EXPECT_TRUE(HashSet<int>::intersectAll({}).empty());
+}
+
+}  // namespace
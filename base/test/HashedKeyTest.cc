@@ -0,0 +1,69 @@
+#include <string>
+
+#include "ConcurrentHashMap.h"
+#include "HashedKey.h"
+#include "gtest/gtest.h"
+
+using pcl::HashedKey;
+using pcl::HashedKeyMap;
+using pcl::HashedKeySet;
+using pcl::HashMap;
+
+namespace {
+
+struct CountingHash {
+  static int num_calls;
+  size_t operator()(const std::string& key) const {
+    ++num_calls;
+    return absl::Hash<std::string>()(key);
+  }
+};
+int CountingHash::num_calls = 0;
+
+TEST(HashedKeyTest, hashOnce) {
+  std::string name = "top/core/alu/adder/u_fa_0/carry_out";
+  CountingHash::num_calls = 0;
+  HashedKey<std::string, CountingHash> key(name);
+  EXPECT_EQ(CountingHash::num_calls, 1);
+  EXPECT_EQ(key.key(), name);
+
+  HashedKeyMap<std::string, int, CountingHash> map1;
+  HashedKeyMap<std::string, double, CountingHash> map2;
+  HashedKeySet<std::string, CountingHash> set;
+  map1.insert(key, 1);
+  map2[key] = 2.0;
+  set.insert(key);
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(map1.value(key), 1);
+    EXPECT_EQ(map2.value(key), 2.0);
+    EXPECT_TRUE(set.hasKey(key));
+  }
+  EXPECT_EQ(CountingHash::num_calls, 1);
+
+  // The plain key is hashed for the lookup.
+  EXPECT_TRUE(map1.hasKey(name));
+  EXPECT_FALSE(set.hasKey(std::string("top/core")));
+  EXPECT_EQ(CountingHash::num_calls, 3);
+}
+
+TEST(HashedKeyTest, equal) {
+  HashedKey<std::string> a("net_a");
+  HashedKey<std::string> b(std::string("net_b"));
+  HashedKey<std::string> c("net_a", a.hash());
+  EXPECT_NE(a, b);
+  EXPECT_EQ(a, c);
+
+  // The default hash of the containers mixes the stored hash only.
+  HashMap<HashedKey<std::string>, int> hmap;
+  hmap[a] = 1;
+  hmap[b] = 2;
+  EXPECT_EQ(hmap.value(c), 1);
+
+  pcl::ConcurrentHashMap<HashedKey<int>, int, pcl::HashedKeyHash<int>,
+                         pcl::HashedKeyEq<int>>
+      cmap(4);
+  cmap.insert(HashedKey<int>(7), 49);
+  EXPECT_EQ(cmap.value(HashedKey<int>(7)), 49);
+}
+
+}  // namespace
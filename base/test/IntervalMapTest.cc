@@ -0,0 +1,97 @@
+#include <tuple>
+#include <vector>
+
+#include "IntervalMap.h"
+#include "gtest/gtest.h"
+
+using pcl::IntervalMap;
+
+namespace {
+
+// The (lo, hi, value) of all segments.
+std::vector<std::tuple<int, int, int>> segments(
+    const IntervalMap<int, int>& imap) {
+  std::vector<std::tuple<int, int, int>> result;
+  for (const auto& p : imap) {
+    result.emplace_back(p.first, p.second.end, p.second.value);
+  }
+  return result;
+}
+
+TEST(IntervalMapTest, assign) {
+  IntervalMap<int, int> imap;
+  imap.assign(0, 10, 1);
+  imap.assign(20, 30, 2);
+  imap.assign(5, 25, 3);
+  EXPECT_EQ(segments(imap), (std::vector<std::tuple<int, int, int>>{
+                                {0, 5, 1}, {5, 25, 3}, {25, 30, 2}}));
+
+  // The touching segments of the equal value are coalesced.
+  imap.assign(25, 40, 3);
+  imap.assign(0, 5, 3);
+  EXPECT_EQ(segments(imap),
+            (std::vector<std::tuple<int, int, int>>{{0, 40, 3}}));
+
+  imap.erase(10, 20);
+  EXPECT_EQ(segments(imap), (std::vector<std::tuple<int, int, int>>{
+                                {0, 10, 3}, {20, 40, 3}}));
+  imap.assign(10, 20, 3);
+  EXPECT_EQ(imap.size(), 1);
+  imap.assign(7, 7, 9);
+  EXPECT_EQ(imap.size(), 1);
+}
+
+TEST(IntervalMapTest, add) {
+  IntervalMap<int, int> usage;
+  usage.add(0, 100, 1);
+  usage.add(50, 200, 1);
+  usage.add(300, 400, 2);
+  EXPECT_EQ(segments(usage), (std::vector<std::tuple<int, int, int>>{
+                                 {0, 50, 1},
+                                 {50, 100, 2},
+                                 {100, 200, 1},
+                                 {300, 400, 2}}));
+
+  usage.add(0, 50, 1);
+  usage.add(200, 300, 2);
+  usage.add(100, 200, 1);
+  EXPECT_EQ(segments(usage),
+            (std::vector<std::tuple<int, int, int>>{{0, 400, 2}}));
+}
+
+TEST(IntervalMapTest, query) {
+  IntervalMap<int, int> imap;
+  imap.assign(0, 10, 1);
+  imap.assign(20, 30, 2);
+  imap.assign(30, 40, 3);
+
+  EXPECT_EQ(imap.value(0), 1);
+  EXPECT_EQ(imap.value(9), 1);
+  EXPECT_EQ(imap.value(10, -1), -1);
+  EXPECT_EQ(imap.value(35), 3);
+  EXPECT_FALSE(imap.contains(15));
+  EXPECT_FALSE(imap.contains(-1));
+  EXPECT_TRUE(imap.find(40) == imap.end());
+  EXPECT_EQ(imap.find(25)->first, 20);
+
+  auto range = imap.overlap(5, 25);
+  ASSERT_EQ(range.size(), 2);
+  EXPECT_EQ(range.begin()->second.value, 1);
+  EXPECT_EQ(std::next(range.begin())->second.value, 2);
+  EXPECT_EQ(imap.overlap(10, 20).size(), 0);
+  EXPECT_FALSE(imap.overlaps(10, 20));
+  EXPECT_TRUE(imap.overlaps(10, 21));
+  EXPECT_EQ(imap.overlap(-5, 100).size(), 3);
+  EXPECT_EQ(imap.overlap(39, 39).size(), 0);
+
+  IntervalMap<int, int> other;
+  other.assign(20, 30, 2);
+  other.assign(0, 10, 1);
+  other.assign(30, 40, 3);
+  EXPECT_EQ(imap, other);
+  other.assign(30, 40, 2);
+  EXPECT_NE(imap, other);
+  EXPECT_EQ(other.size(), 2);
+}
+
+}  // namespace
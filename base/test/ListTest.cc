@@ -1,4 +1,5 @@
 #include <iostream>
+#include <memory>
 
 #include "List.h"
 #include "gtest/gtest.h"
@@ -137,3 +138,22 @@ TEST(ListTest, operator) {
   std::cout << compare1 << std::endl;
   std::cout << compare2 << std::endl;
 }
+TEST(ListTest, concat) {
+  pcl::List<int> el1{1, 2};
+  pcl::List<int> el2{3, 4};
+  pcl::List<int> el3 = el1 + el2;
+  EXPECT_EQ(el3, pcl::List<int>({1, 2, 3, 4}));
+  EXPECT_EQ(el1.size(), 2);
+
+  pcl::List<int> el4 = el1 + pcl::List<int>{5} + el2;
+  EXPECT_EQ(el4, pcl::List<int>({1, 2, 5, 3, 4}));
+
+  pcl::List<std::unique_ptr<int>> owners1;
+  pcl::List<std::unique_ptr<int>> owners2;
+  owners1.push_back(std::make_unique<int>(1));
+  owners2.push_back(std::make_unique<int>(2));
+  int* second = owners2.front().get();
+  auto owners = std::move(owners1) + std::move(owners2);
+  EXPECT_EQ(owners.size(), 2);
+  EXPECT_EQ(owners.back().get(), second);
+}
@@ -3,10 +3,14 @@
 #include <functional>
 #include <iterator>
 #include <map>
+#include <memory>
 #include <random>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "Map.h"
+#include "absl/strings/string_view.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest-death-test.h"
 #include "gtest/gtest.h"
@@ -884,4 +888,136 @@ TEST(MapTest, perf4) {
   timeit(set_erase, "erase");
 }
 
+TEST(MapTest, keysView) {
+  Map<int, int> bmap = {{3, 30}, {1, 10}, {2, 20}};
+  auto keys = bmap.keysView();
+  EXPECT_EQ(keys.size(), 3);
+  EXPECT_EQ(*keys.begin(), 1);
+  std::vector<int> key_vec(keys.begin(), keys.end());
+  EXPECT_EQ(key_vec, std::vector<int>({1, 2, 3}));
+
+  for (auto& value : bmap.valuesView()) {
+    value *= 2;
+  }
+  pcl::Vector<int> values;
+  bmap.valuesInto(&values);
+  EXPECT_EQ(values[0], 20);
+  EXPECT_EQ(values[2], 60);
+
+  pcl::Vector<int> more_keys;
+  bmap.keysInto(&more_keys);
+  EXPECT_EQ(more_keys.back(), 3);
+}
+
+TEST(MapTest, heterogeneous) {
+  Map<std::string, std::unique_ptr<int>> bmap;
+  bmap.insert("a", std::make_unique<int>(1));
+  auto value = std::make_unique<int>(2);
+  bmap.insert(std::string("b"), std::move(value));
+  EXPECT_EQ(value, nullptr);
+  bmap.insert(absl::string_view("a"), std::make_unique<int>(3));
+  EXPECT_EQ(bmap.size(), 2);
+  EXPECT_EQ(*bmap.find("a")->second, 3);
+  EXPECT_TRUE(bmap.hasKey(absl::string_view("b")));
+  EXPECT_FALSE(bmap.hasKey("c"));
+
+  Map<std::string, int> counts{{"x", 1}, {"y", 2}};
+  EXPECT_EQ(counts.value(absl::string_view("y")), 2);
+  EXPECT_EQ(counts.value("z", -1), -1);
+
+  Multimap<std::string, int> bmultimap;
+  bmultimap.insert("x", 1);
+  bmultimap.insert(std::string("x"), 2);
+  EXPECT_EQ(bmultimap.values(absl::string_view("x")).size(), 2);
+}
+
+TEST(MapTest, fromSorted) {
+  std::vector<std::pair<int, int>> items;
+  for (int i = 0; i < 10000; ++i) {
+    items.emplace_back(i / 2 * 2, i);
+  }
+  auto bmap = Map<int, int>::fromSorted(items.begin(), items.end());
+  Map<int, int> expected;
+  for (auto& [key, value] : items) {
+    expected.insert(std::make_pair(key, value));
+  }
+  EXPECT_EQ(bmap.size(), 5000);
+  EXPECT_TRUE(bmap == expected);
+  EXPECT_EQ(bmap.value(4), 4);
+
+  std::vector<std::pair<int, int>> more{{10000, 1}, {10002, 2}, {3, 3}};
+  bmap.appendSorted(more.begin(), more.end());
+  EXPECT_EQ(bmap.size(), 5003);
+  EXPECT_EQ(bmap.value(3), 3);
+  EXPECT_EQ(bmap.rbegin()->first, 10002);
+
+  auto bmultimap =
+      Multimap<int, int>::fromSorted(items.begin(), items.end());
+  EXPECT_EQ(bmultimap.size(), 10000);
+  auto range = bmultimap.equal_range(4);
+  EXPECT_EQ(range.first->second, 4);
+  EXPECT_EQ(std::next(range.first)->second, 5);
+  bmultimap.appendSorted(more.begin(), more.end());
+  EXPECT_EQ(bmultimap.count(3), 1);
+  EXPECT_EQ(bmultimap.size(), 10003);
+}
+
+TEST(MultimapTest, forEachGroup) {
+  Multimap<int, int> net_pins;
+  for (int i = 0; i < 20000; ++i) {
+    net_pins.insert(i % 1000, i);
+  }
+  for (int i = 0; i < 5000; ++i) {
+    net_pins.insert(500, -i);
+  }
+
+  std::vector<int> keys;
+  net_pins.forEachGroup([&](int key, auto pins) {
+    keys.push_back(key);
+    auto range = net_pins.equal_range(key);
+    EXPECT_EQ(pins.size(), std::distance(range.first, range.second));
+    EXPECT_TRUE(std::equal(pins.begin(), pins.end(),
+                           pcl::ValueIterator<decltype(range.first)>(
+                               range.first)));
+  });
+  EXPECT_EQ(keys.size(), 1000);
+  EXPECT_TRUE(std::is_sorted(keys.begin(), keys.end()));
+
+  net_pins.forEachGroup([](int, auto pins) {
+    for (int& pin : pins) {
+      pin *= 2;
+    }
+  });
+  EXPECT_EQ(net_pins.find(3)->second, 6);
+
+  for (int num_threads : {1, 4, 64}) {
+    std::vector<int> visits(1000);
+    std::vector<size_t> sizes(1000);
+    const auto& const_pins = net_pins;
+    const_pins.forEachGroup(num_threads, [&](int key, auto pins) {
+      ++visits[key];
+      sizes[key] = pins.size();
+    });
+    EXPECT_EQ(std::count(visits.begin(), visits.end(), 1), 1000);
+    EXPECT_EQ(sizes[500], 5020);
+    EXPECT_EQ(sizes[1], 20);
+  }
+
+  Multimap<int, int> empty;
+  empty.forEachGroup(4, [](int, auto) { FAIL(); });
+
+  // The single group spans all chunks and is visited once.
+  Multimap<int, int> one_net;
+  for (int i = 0; i < 100; ++i) {
+    one_net.insert(7, i);
+  }
+  int num_visits = 0;
+  one_net.forEachGroup(8, [&](int key, auto pins) {
+    ++num_visits;
+    EXPECT_EQ(key, 7);
+    EXPECT_EQ(pins.size(), 100);
+  });
+  EXPECT_EQ(num_visits, 1);
+}
+
 }  // namespace
@@ -0,0 +1,157 @@
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "OrderStatisticTree.h"
+#include "gtest/gtest.h"
+
+using pcl::OrderStatisticMap;
+using pcl::OrderStatisticSet;
+
+namespace {
+
+TEST(OrderStatisticTreeTest, basic) {
+  OrderStatisticSet<int> oset = {50, 10, 40, 20, 30};
+  EXPECT_EQ(oset.size(), 5);
+  EXPECT_FALSE(oset.insert(30));
+  EXPECT_EQ(*oset.select(0), 10);
+  EXPECT_EQ(*oset.select(4), 50);
+  EXPECT_TRUE(oset.select(5) == oset.end());
+  EXPECT_EQ(oset.rank(10), 0);
+  EXPECT_EQ(oset.rank(35), 3);
+  EXPECT_EQ(oset.rank(100), 5);
+  EXPECT_EQ(oset.countRange(15, 45), 3);
+  EXPECT_EQ(oset.countRange(45, 15), 0);
+  EXPECT_EQ(*oset.lower_bound(35), 40);
+
+  EXPECT_EQ(oset.erase(30), 1);
+  EXPECT_EQ(oset.erase(30), 0);
+  std::vector<int> keys(oset.begin(), oset.end());
+  EXPECT_EQ(keys, std::vector<int>({10, 20, 40, 50}));
+}
+
+TEST(OrderStatisticTreeTest, random) {
+  std::mt19937 gen(11);
+  OrderStatisticSet<int> oset;
+  std::set<int> expect;
+  for (int round = 0; round < 40000; ++round) {
+    int key = gen() % 20000;
+    if (gen() % 3 == 0) {
+      EXPECT_EQ(oset.erase(key), expect.erase(key));
+    } else {
+      EXPECT_EQ(oset.insert(key), expect.insert(key).second);
+    }
+  }
+  ASSERT_EQ(oset.size(), expect.size());
+  EXPECT_TRUE(std::equal(oset.begin(), oset.end(), expect.begin()));
+
+  std::vector<int> sorted(expect.begin(), expect.end());
+  for (size_t k = 0; k < sorted.size(); k += 7) {
+    EXPECT_EQ(*oset.select(k), sorted[k]);
+    EXPECT_EQ(oset.rank(sorted[k]), k);
+  }
+  for (int lo = 0; lo < 20000; lo += 997) {
+    int hi = lo + 3000;
+    EXPECT_EQ(oset.countRange(lo, hi),
+              std::distance(expect.lower_bound(lo), expect.lower_bound(hi)));
+  }
+
+  OrderStatisticSet<int> copy = oset;
+  for (int key : sorted) {
+    oset.erase(key);
+  }
+  EXPECT_TRUE(oset.empty());
+  EXPECT_TRUE(oset.begin() == oset.end());
+  EXPECT_EQ(copy.size(), sorted.size());
+  EXPECT_TRUE(std::equal(copy.begin(), copy.end(), sorted.begin()));
+}
+
+TEST(OrderStatisticTreeTest, blockErase) {
+  // The block erase leaves the nodes less than half full whose siblings can
+  // not merge, the nodes take the items from the siblings instead.
+  std::vector<int> keys(200000);
+  for (int key = 0; key < 200000; ++key) {
+    keys[key] = key;
+  }
+  std::mt19937 gen(1);
+  std::shuffle(keys.begin(), keys.end(), gen);
+  OrderStatisticSet<int> oset;
+  oset.insert(keys.begin(), keys.end());
+  std::set<int> expect(keys.begin(), keys.end());
+  for (int trial = 0; trial < 200; ++trial) {
+    int first = gen() % 200000;
+    for (int key = first; key < first + 50; ++key) {
+      EXPECT_EQ(oset.erase(key), expect.erase(key));
+    }
+    if (trial % 20 == 0) {
+      ASSERT_EQ(oset.size(), expect.size());
+      ASSERT_TRUE(std::equal(oset.begin(), oset.end(), expect.begin()));
+    }
+  }
+  ASSERT_EQ(oset.size(), expect.size());
+  ASSERT_TRUE(std::equal(oset.begin(), oset.end(), expect.begin()));
+  std::vector<int> sorted(expect.begin(), expect.end());
+  for (size_t k = 0; k < sorted.size(); k += 101) {
+    EXPECT_EQ(*oset.select(k), sorted[k]);
+    EXPECT_EQ(oset.rank(sorted[k]), k);
+  }
+
+  // Erase the blocks until empty, in random order.
+  std::vector<int> blocks;
+  for (int first = 0; first < 200000; first += 500) {
+    blocks.push_back(first);
+  }
+  std::shuffle(blocks.begin(), blocks.end(), gen);
+  for (size_t b = 0; b < blocks.size(); ++b) {
+    for (int key = blocks[b]; key < blocks[b] + 500; ++key) {
+      oset.erase(key);
+      expect.erase(key);
+    }
+    if (b % 40 == 0) {
+      ASSERT_EQ(oset.size(), expect.size());
+      ASSERT_TRUE(std::equal(oset.begin(), oset.end(), expect.begin()));
+    }
+  }
+  EXPECT_TRUE(oset.empty());
+  EXPECT_TRUE(oset.begin() == oset.end());
+}
+
+TEST(OrderStatisticTreeTest, move) {
+  OrderStatisticSet<int> oset = {1, 2, 3};
+  OrderStatisticSet<int> moved(std::move(oset));
+  EXPECT_EQ(moved.size(), 3);
+  EXPECT_EQ(oset.size(), 0);
+  EXPECT_TRUE(oset.empty());
+  EXPECT_TRUE(oset.select(0) == oset.end());
+  EXPECT_TRUE(oset.begin() == oset.end());
+
+  oset = std::move(moved);
+  EXPECT_EQ(*oset.select(2), 3);
+  EXPECT_EQ(moved.size(), 0);
+  EXPECT_TRUE(moved.select(0) == moved.end());
+  oset.insert(4);
+  moved.insert(5);
+  EXPECT_EQ(oset.size(), 4);
+  EXPECT_EQ(moved.size(), 1);
+}
+
+TEST(OrderStatisticTreeTest, map) {
+  OrderStatisticMap<double, std::string> slacks;
+  slacks.insert(-0.5, "a");
+  slacks.insert(0.25, "b");
+  slacks.insert(-1.5, "c");
+  slacks.insert(0.25, "d");
+  slacks[1.0] = "e";
+  EXPECT_EQ(slacks.size(), 4);
+  EXPECT_EQ(slacks.value(0.25), "d");
+  EXPECT_EQ(slacks.value(2.0, "none"), "none");
+  EXPECT_EQ(slacks.rank(0.0), 2);
+  EXPECT_EQ(slacks.select(0)->second, "c");
+  EXPECT_TRUE(slacks.hasKey(1.0));
+}
+
+}  // namespace
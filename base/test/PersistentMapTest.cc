@@ -0,0 +1,169 @@
+#include <algorithm>
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "PersistentMap.h"
+#include "gtest/gtest.h"
+
+using pcl::PersistentMap;
+using pcl::PersistentSet;
+
+namespace {
+
+TEST(PersistentMapTest, snapshot) {
+  PersistentMap<std::string, int> pmap = {{"a", 1}, {"b", 2}};
+  auto baseline = pmap.snapshot();
+  EXPECT_TRUE(baseline.sharesWith(pmap));
+
+  pmap.insert("c", 3);
+  pmap.insert("a", 10);
+  pmap.update("b", [](int& value) { value += 20; });
+  pmap.erase("zz");
+  EXPECT_FALSE(baseline.sharesWith(pmap));
+
+  EXPECT_EQ(pmap.size(), 3);
+  EXPECT_EQ(pmap.value("a"), 10);
+  EXPECT_EQ(pmap.value("b"), 22);
+  EXPECT_EQ(baseline.size(), 2);
+  EXPECT_EQ(baseline.value("a"), 1);
+  EXPECT_EQ(baseline.value("b"), 2);
+  EXPECT_FALSE(baseline.hasKey("c"));
+  EXPECT_FALSE(pmap.update("zz", [](int&) {}));
+
+  pmap.erase("a");
+  EXPECT_FALSE(pmap.hasKey("a"));
+  EXPECT_TRUE(baseline.hasKey("a"));
+}
+
+TEST(PersistentMapTest, random) {
+  std::mt19937 gen(5);
+  PersistentMap<int, int> pmap;
+  std::map<int, int> expect;
+  std::vector<std::pair<PersistentMap<int, int>, std::map<int, int>>> history;
+  for (int round = 0; round < 30000; ++round) {
+    int key = gen() % 5000;
+    if (gen() % 3 == 0) {
+      EXPECT_EQ(pmap.erase(key), expect.erase(key));
+    } else {
+      pmap.insert(key, round);
+      expect[key] = round;
+    }
+    if (round % 3000 == 0) {
+      history.emplace_back(pmap.snapshot(), expect);
+    }
+  }
+  history.emplace_back(pmap.snapshot(), expect);
+  for (const auto& [snapshot, expect_map] : history) {
+    ASSERT_EQ(snapshot.size(), expect_map.size());
+    auto iter = snapshot.begin();
+    for (const auto& p : expect_map) {
+      ASSERT_EQ(iter->first, p.first);
+      ASSERT_EQ(iter->second, p.second);
+      ++iter;
+    }
+    EXPECT_TRUE(iter == snapshot.end());
+  }
+}
+
+TEST(PersistentMapTest, blockErase) {
+  // The block erase leaves the nodes less than half full whose siblings can
+  // not merge, the nodes take the items from the siblings instead, and the
+  // snapshots sharing the nodes are unchanged.
+  PersistentSet<int> pset;
+  std::set<int> expect;
+  for (int key = 0; key < 200000; ++key) {
+    pset.insert(key);
+    expect.insert(key);
+  }
+  std::mt19937 gen(1);
+  std::vector<std::pair<PersistentSet<int>, std::set<int>>> history;
+  for (int trial = 0; trial < 4000 && !expect.empty(); ++trial) {
+    if (trial % 400 == 0) {
+      history.emplace_back(pset.snapshot(), expect);
+    }
+    int first = gen() % 200000;
+    for (int key = first; key < first + 50; ++key) {
+      EXPECT_EQ(pset.erase(key), expect.erase(key));
+    }
+    if (trial % 100 == 0) {
+      ASSERT_EQ(pset.size(), expect.size());
+      ASSERT_TRUE(std::equal(pset.begin(), pset.end(), expect.begin()));
+    }
+  }
+  ASSERT_EQ(pset.size(), expect.size());
+  ASSERT_TRUE(std::equal(pset.begin(), pset.end(), expect.begin()));
+  for (const auto& [snapshot, expect_set] : history) {
+    ASSERT_EQ(snapshot.size(), expect_set.size());
+    ASSERT_TRUE(
+        std::equal(snapshot.begin(), snapshot.end(), expect_set.begin()));
+  }
+}
+
+TEST(PersistentMapTest, move) {
+  PersistentMap<int, int> pmap = {{1, 1}, {2, 2}, {3, 3}};
+  PersistentMap<int, int> moved(std::move(pmap));
+  EXPECT_EQ(moved.size(), 3);
+  EXPECT_EQ(pmap.size(), 0);
+  EXPECT_TRUE(pmap.empty());
+  EXPECT_TRUE(pmap.begin() == pmap.end());
+
+  pmap = std::move(moved);
+  EXPECT_EQ(pmap.value(3), 3);
+  EXPECT_TRUE(moved.empty());
+  moved.insert(4, 4);
+  EXPECT_EQ(moved.size(), 1);
+  EXPECT_EQ(pmap.size(), 3);
+}
+
+TEST(PersistentMapTest, concurrentRead) {
+  PersistentSet<int> pset;
+  for (int i = 0; i < 10000; ++i) {
+    pset.insert(i * 2);
+  }
+  PersistentSet<int> baseline = pset.snapshot();
+  bool reader_ok = true;
+  std::thread reader([&baseline, &reader_ok]() {
+    for (int round = 0; round < 20; ++round) {
+      size_t num = 0;
+      for (int key : baseline) {
+        reader_ok &= key % 2 == 0;
+        ++num;
+      }
+      reader_ok &= num == 10000 && baseline.contains(100) &&
+                   !baseline.contains(101);
+    }
+  });
+  for (int i = 0; i < 10000; ++i) {
+    pset.insert(i * 2 + 1);
+    pset.erase(i * 2);
+  }
+  reader.join();
+  EXPECT_TRUE(reader_ok);
+  EXPECT_EQ(pset.size(), 10000);
+  EXPECT_TRUE(pset.contains(101));
+  EXPECT_FALSE(pset.contains(100));
+
+  // The reader drops its snapshot while the map is modified, the nodes
+  // become unshared and are then modified in place.
+  size_t num_odd = 0;
+  std::thread releaser([snapshot = pset.snapshot(), &num_odd]() mutable {
+    for (int key : snapshot) {
+      num_odd += key % 2;
+    }
+    snapshot = PersistentSet<int>();
+  });
+  for (int i = 0; i < 10000; ++i) {
+    pset.erase(i * 2 + 1);
+    pset.insert(i * 2);
+  }
+  releaser.join();
+  EXPECT_EQ(num_odd, 10000);
+  EXPECT_EQ(pset.size(), 10000);
+  EXPECT_TRUE(pset.contains(100));
+}
+
+}  // namespace
@@ -1,7 +1,10 @@
+#include <algorithm>
 #include <chrono>
 #include <functional>
+#include <iterator>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "Set.h"
 #include "gtest/gtest.h"
@@ -346,6 +349,107 @@ TEST(SetTest, intersects) {
   EXPECT_TRUE(Set<int>::intersects(&cont, &cont1));
 }
 
+TEST(SetTest, algebra) {
+  // The similar sizes take the linear merge, the different sizes gallop.
+  for (int step : {3, 1000}) {
+    Set<int> set1;
+    Set<int> set2;
+    std::vector<int> vec1;
+    std::vector<int> vec2;
+    for (int i = 0; i < 100000; i += 2) {
+      set1.insert(i);
+      vec1.push_back(i);
+    }
+    for (int i = 0; i < 100000; i += step) {
+      set2.insert(i);
+      vec2.push_back(i);
+    }
+
+    std::vector<int> expect;
+    std::set_union(vec1.begin(), vec1.end(), vec2.begin(), vec2.end(),
+                   std::back_inserter(expect));
+    Set<int> result = set1 | set2;
+    EXPECT_TRUE(std::equal(result.begin(), result.end(), expect.begin(),
+                           expect.end()));
+    result = set2;
+    result.unite(set1);
+    EXPECT_TRUE(std::equal(result.begin(), result.end(), expect.begin(),
+                           expect.end()));
+
+    expect.clear();
+    std::set_intersection(vec1.begin(), vec1.end(), vec2.begin(), vec2.end(),
+                          std::back_inserter(expect));
+    result = set1 & set2;
+    EXPECT_TRUE(std::equal(result.begin(), result.end(), expect.begin(),
+                           expect.end()));
+    result = set2 & set1;
+    EXPECT_TRUE(std::equal(result.begin(), result.end(), expect.begin(),
+                           expect.end()));
+
+    expect.clear();
+    std::set_difference(vec1.begin(), vec1.end(), vec2.begin(), vec2.end(),
+                        std::back_inserter(expect));
+    result = set1 - set2;
+    EXPECT_TRUE(std::equal(result.begin(), result.end(), expect.begin(),
+                           expect.end()));
+    result = set1;
+    result.subtract(set2);
+    EXPECT_TRUE(std::equal(result.begin(), result.end(), expect.begin(),
+                           expect.end()));
+
+    expect.clear();
+    std::set_difference(vec2.begin(), vec2.end(), vec1.begin(), vec1.end(),
+                        std::back_inserter(expect));
+    result = set2 - set1;
+    EXPECT_TRUE(std::equal(result.begin(), result.end(), expect.begin(),
+                           expect.end()));
+  }
+
+  Set<int> empty;
+  Set<int> set1 = {1, 2, 3};
+  EXPECT_TRUE((set1 & empty).empty());
+  EXPECT_EQ(set1 | empty, set1);
+  EXPECT_EQ(set1 - empty, set1);
+  EXPECT_TRUE((empty - set1).empty());
+}
+
+TEST(SetTest, intersectAll) {
+  // The set i has the multiples of i + 2 in [0, 60000), and the set 4 is
+  // much smaller to gallop.
+  std::vector<Set<int>> sets(5);
+  for (int i = 0; i < 4; ++i) {
+    for (int k = 0; k < 60000; k += i + 2) {
+      sets[i].insert(k);
+    }
+  }
+  for (int k = 0; k < 60000; k += 600) {
+    sets[4].insert(k);
+  }
+  std::vector<const Set<int>*> set_ptrs = {&sets[0], &sets[1], &sets[2],
+                                           &sets[3], &sets[4]};
+  for (int num_threads : {1, 4}) {
+    Set<int> result = Set<int>::intersectAll(set_ptrs, num_threads);
+    Set<int> expect = sets[0];
+    for (const auto& set : sets) {
+      expect &= set;
+    }
+    EXPECT_EQ(result.size(), 100);
+    EXPECT_EQ(result, expect);
+
+    result = Set<int>::uniteAll(set_ptrs, num_threads);
+    expect.clear();
+    for (const auto& set : sets) {
+      expect |= set;
+    }
+    EXPECT_EQ(result, expect);
+  }
+
+  set_ptrs.push_back(nullptr);
+  EXPECT_TRUE(Set<int>::intersectAll(set_ptrs).empty());
+  EXPECT_EQ(Set<int>::uniteAll(set_ptrs, 3).size(), 44000);
+  EXPECT_TRUE(Set<int>::uniteAll({}).empty());
+}
+
 TEST(SetTest, nonmember1) {
   Set<int> cont = {1, 2, 3, 4, 5};
   Set<int> cont1 = {1, 2, 3};
@@ -527,6 +631,26 @@ TEST(MultisetTest, nonmember7) {
   EXPECT_EQ(bmultiset1, result);
 }
 
+TEST(MultisetTest, fromSorted) {
+  std::vector<int> keys;
+  for (int i = 0; i < 10000; ++i) {
+    keys.push_back(i / 2);
+  }
+  auto bset = Set<int>::fromSorted(keys.begin(), keys.end());
+  EXPECT_EQ(bset.size(), 5000);
+  EXPECT_EQ(bset, Set<int>(keys.begin(), keys.end()));
+  std::vector<int> more{5000, 5001, 7};
+  bset.appendSorted(more.begin(), more.end());
+  EXPECT_EQ(bset.size(), 5002);
+
+  auto bmultiset = Multiset<int>::fromSorted(keys.begin(), keys.end());
+  EXPECT_EQ(bmultiset.size(), 10000);
+  EXPECT_EQ(bmultiset.count(7), 2);
+  bmultiset.appendSorted(more.begin(), more.end());
+  EXPECT_EQ(bmultiset.count(7), 3);
+  EXPECT_TRUE(std::is_sorted(bmultiset.begin(), bmultiset.end()));
+}
+
 class Dew {
  private:
   int _a;
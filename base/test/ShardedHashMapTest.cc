@@ -0,0 +1,102 @@
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ShardedHashMap.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+using pcl::HashMap;
+using pcl::HashSet;
+using pcl::ShardedHashMap;
+using pcl::ShardedHashSet;
+
+TEST(ShardedHashMapTest, insertParallel) {
+  // The duplicated keys, the later one wins.
+  std::vector<std::pair<int, int>> elements;
+  for (int i = 0; i < 100000; ++i) {
+    elements.emplace_back(i % 40000, i);
+  }
+  HashMap<int, int> expected;
+  for (const auto& p : elements) {
+    expected.insert(p.first, p.second);
+  }
+
+  for (int num_threads : {1, 4}) {
+    ShardedHashMap<int, int> smap;
+    smap.insertParallel(elements.begin(), elements.end(), num_threads);
+    EXPECT_EQ(smap.numShards(), 64);
+    EXPECT_EQ(smap.size(), 40000);
+    for (const auto& p : expected) {
+      const auto* element = smap.find(p.first);
+      ASSERT_TRUE(element != nullptr);
+      EXPECT_EQ(element->second, p.second);
+    }
+    EXPECT_FALSE(smap.hasKey(40000));
+    EXPECT_EQ(smap.flatten(), expected);
+  }
+
+  ShardedHashMap<std::string, int> names(5);
+  EXPECT_EQ(names.numShards(), 8);
+  std::vector<std::pair<std::string, int>> name_elements;
+  for (int i = 0; i < 20000; ++i) {
+    name_elements.emplace_back("net_" + std::to_string(i), i);
+  }
+  names.insertParallel(name_elements.begin(), name_elements.end(), 3);
+  EXPECT_EQ(names.size(), 20000);
+  EXPECT_EQ(names.find("net_12345")->second, 12345);
+
+  // The identity hash still spreads the keys over the shards.
+  struct IdentityHash {
+    size_t operator()(int key) const { return static_cast<size_t>(key); }
+  };
+  ShardedHashMap<int, int, IdentityHash> identity(4);
+  identity.insertParallel(elements.begin(), elements.end(), 2);
+  for (size_t s = 0; s < identity.numShards(); ++s) {
+    EXPECT_GT(identity.shard(s).size(), 5000);
+  }
+  EXPECT_EQ(identity.find(39999)->second, 79999);
+}
+
+TEST(ShardedHashMapTest, uniteParallel) {
+  std::vector<int> keys;
+  for (int i = 0; i < 100000; ++i) {
+    keys.push_back(i % 30000);
+  }
+  ShardedHashSet<int> sset;
+  sset.insertParallel(keys.begin(), keys.end(), 4);
+  EXPECT_EQ(sset.size(), 30000);
+  EXPECT_TRUE(sset.hasKey(29999));
+  EXPECT_FALSE(sset.hasKey(30000));
+
+  std::vector<int> other_keys;
+  for (int i = 20000; i < 60000; ++i) {
+    other_keys.push_back(i);
+  }
+  ShardedHashSet<int> other;
+  other.insertParallel(other_keys.begin(), other_keys.end(), 4);
+  sset.uniteParallel(other, 4);
+  EXPECT_EQ(sset.size(), 60000);
+  EXPECT_TRUE(sset.hasKey(59999));
+  EXPECT_TRUE(sset.hasKey(0));
+
+  // The other of a different shard number is rehashed into the shards.
+  ShardedHashSet<int> fewer(2);
+  fewer.insertParallel(other_keys.begin(), other_keys.end(), 1);
+  ShardedHashSet<int> more(16);
+  more.uniteParallel(fewer, 3);
+  EXPECT_EQ(more.size(), 40000);
+  size_t num_visited = 0;
+  more.forEach([&](int key) {
+    EXPECT_TRUE(fewer.hasKey(key));
+    ++num_visited;
+  });
+  EXPECT_EQ(num_visited, 40000);
+
+  more.clear();
+  EXPECT_TRUE(more.empty());
+  EXPECT_FALSE(more.hasKey(20000));
+}
+
+}  // namespace
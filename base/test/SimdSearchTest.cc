@@ -0,0 +1,99 @@
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "SimdSearch.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+using pcl::simdCount;
+using pcl::simdFind;
+using pcl::simdFindLast;
+
+// Check the kernels against the std algorithms on every sub range length and
+// every needle position around the register boundaries.
+template <typename T>
+void checkKernels(const std::vector<T>& values, const T& needle) {
+  for (size_t n = 0; n <= values.size(); ++n) {
+    const T* first = values.data();
+    const T* last = first + n;
+    EXPECT_EQ(simdFind(first, last, needle), std::find(first, last, needle));
+    EXPECT_EQ(simdCount(first, last, needle),
+              static_cast<size_t>(std::count(first, last, needle)));
+    const T* expected = last;
+    for (const T* p = first; p != last; ++p) {
+      if (*p == needle) {
+        expected = p;
+      }
+    }
+    EXPECT_EQ(simdFindLast(first, last, needle), expected);
+  }
+}
+
+template <typename T>
+void checkType() {
+  std::mt19937 engine(7);
+  std::vector<T> values(150);
+  for (auto& v : values) {
+    v = static_cast<T>(engine() % 4 + 1);
+  }
+  checkKernels(values, static_cast<T>(0));
+  checkKernels(values, static_cast<T>(3));
+  for (size_t pos : {0, 1, 15, 16, 31, 32, 63, 64, 127, 149}) {
+    std::vector<T> single(150, static_cast<T>(1));
+    single[pos] = static_cast<T>(2);
+    checkKernels(single, static_cast<T>(2));
+  }
+}
+
+TEST(SimdSearchTest, integral) {
+  EXPECT_TRUE(pcl::detail::kSimdSearchable<int> ||
+              pcl::detail::kSimdBytes == 0);
+  checkType<int8_t>();
+  checkType<uint16_t>();
+  checkType<int>();
+  checkType<int64_t>();
+  checkType<uint64_t>();
+  checkType<char>();
+
+  // The byte lane counters are summed before they overflow.
+  std::vector<int8_t> bytes(100003, 1);
+  bytes[5] = 2;
+  EXPECT_EQ(simdCount(bytes.data(), bytes.data() + bytes.size(), int8_t(1)),
+            100002);
+  EXPECT_EQ(simdFindLast(bytes.data(), bytes.data() + bytes.size(), int8_t(2)),
+            bytes.data() + 5);
+}
+
+TEST(SimdSearchTest, floating) {
+  checkType<float>();
+  checkType<double>();
+
+  std::vector<double> values(40, 1.0);
+  values[5] = std::numeric_limits<double>::quiet_NaN();
+  values[9] = -0.0;
+  EXPECT_EQ(simdFind(values.data(), values.data() + 40, values[5]),
+            values.data() + 40);
+  EXPECT_EQ(simdFind(values.data(), values.data() + 40, 0.0),
+            values.data() + 9);
+  EXPECT_EQ(simdCount(values.data(), values.data() + 40, 1.0), 38);
+}
+
+TEST(SimdSearchTest, pointer) {
+  std::vector<int> cells(100);
+  std::vector<int*> values;
+  for (auto& cell : cells) {
+    values.push_back(&cell);
+  }
+  values.push_back(&cells[3]);
+  checkKernels(values, &cells[3]);
+  checkKernels(values, static_cast<int*>(nullptr));
+  EXPECT_FALSE(pcl::detail::kSimdSearchable<std::string>);
+  checkKernels(std::vector<std::string>{"a", "b", "a"}, std::string("a"));
+}
+
+}  // namespace
@@ -0,0 +1,108 @@
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "SnapshotHashMap.h"
+#include "gtest/gtest.h"
+
+using pcl::SnapshotHashMap;
+
+namespace {
+
+TEST(SnapshotHashMapTest, basic) {
+  SnapshotHashMap<std::string, int> hmap;
+  EXPECT_TRUE(hmap.empty());
+
+  SnapshotHashMap<std::string, int>::Batch batch;
+  batch.insert("a", 1);
+  batch.insert("b", 2);
+  batch.insert("c", 3);
+  batch.erase("b");
+  hmap.commit(std::move(batch));
+  EXPECT_TRUE(batch.empty());
+
+  EXPECT_EQ(hmap.size(), 2);
+  EXPECT_TRUE(hmap.hasKey("a"));
+  EXPECT_FALSE(hmap.hasKey("b"));
+  EXPECT_EQ(hmap.value("c"), 3);
+  EXPECT_EQ(hmap.value("d", -1), -1);
+
+  auto snapshot = hmap.snapshot();
+  hmap.insert("d", 4);
+  hmap.erase("a");
+  int value = 0;
+  EXPECT_TRUE(hmap.find("d", &value));
+  EXPECT_EQ(value, 4);
+  EXPECT_FALSE(hmap.hasKey("a"));
+
+  // The snapshot still sees the old version.
+  EXPECT_EQ(snapshot->size(), 2);
+  EXPECT_EQ(snapshot->value("a"), 1);
+  EXPECT_FALSE(snapshot->contains("d"));
+  EXPECT_GT(hmap.numRetired(), 0);
+}
+
+TEST(SnapshotHashMapTest, reclaim) {
+  SnapshotHashMap<int, int> hmap;
+  for (int i = 0; i < 10; ++i) {
+    hmap.insert(i, i);
+  }
+  hmap.reclaim();
+  EXPECT_EQ(hmap.numRetired(), 0);
+
+  {
+    auto snapshot = hmap.snapshot();
+    hmap.update([](SnapshotHashMap<int, int>::Table& table) { table.clear(); });
+    hmap.reclaim();
+    EXPECT_EQ(hmap.numRetired(), 1);
+    EXPECT_EQ(snapshot->size(), 10);
+  }
+  hmap.reclaim();
+  EXPECT_EQ(hmap.numRetired(), 0);
+  EXPECT_TRUE(hmap.empty());
+}
+
+TEST(SnapshotHashMapTest, concurrent) {
+  const int num_keys = 100;
+  SnapshotHashMap<int, int> hmap;
+  SnapshotHashMap<int, int>::Table table;
+  for (int i = 0; i < num_keys; ++i) {
+    table[i] = 0;
+  }
+  hmap.reset(std::move(table));
+
+  // Each version maps all keys to the same value, the reader must never see a
+  // mixed version.
+  std::atomic<bool> stop{false};
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 4; ++t) {
+    readers.emplace_back([&hmap, &stop]() {
+      while (!stop.load()) {
+        auto snapshot = hmap.snapshot();
+        int first = snapshot->value(0);
+        for (int i = 1; i < num_keys; ++i) {
+          ASSERT_EQ(snapshot->value(i), first);
+        }
+      }
+    });
+  }
+
+  for (int version = 1; version <= 200; ++version) {
+    hmap.update([version](SnapshotHashMap<int, int>::Table& table) {
+      for (auto& p : table) {
+        p.second = version;
+      }
+    });
+  }
+  stop.store(true);
+  for (auto& t : readers) {
+    t.join();
+  }
+
+  hmap.reclaim();
+  EXPECT_EQ(hmap.numRetired(), 0);
+  EXPECT_EQ(hmap.value(num_keys - 1), 200);
+}
+
+}  // namespace
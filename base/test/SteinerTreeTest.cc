@@ -0,0 +1,68 @@
+#include <iostream>
+
+#include "SteinerTree.h"
+#include "gtest/gtest.h"
+
+using pcl::Point;
+using pcl::SteinerTree;
+using pcl::Vector;
+using pcl::WirelengthModel;
+
+namespace {
+
+TEST(SteinerTreeTest, hpwl) {
+  Vector<Point> points{{0, 0}, {10, 5}, {3, 8}};
+  EXPECT_EQ(SteinerTree::hpwl(points), 18);
+
+  Vector<Point> one{{3, 3}};
+  EXPECT_EQ(SteinerTree::hpwl(one), 0);
+}
+
+TEST(SteinerTreeTest, mst) {
+  Vector<Point> points{{0, 0}, {10, 0}, {0, 10}, {10, 10}};
+  EXPECT_EQ(SteinerTree::mstWirelength(points), 30);
+
+  Vector<Point> two{{0, 0}, {3, 4}};
+  EXPECT_EQ(SteinerTree::mstWirelength(two), 7);
+}
+
+TEST(SteinerTreeTest, steiner) {
+  // The three pin net is exactly the half perimeter.
+  Vector<Point> three{{0, 0}, {10, 5}, {3, 8}};
+  EXPECT_EQ(SteinerTree::steinerWirelength(three), 18);
+
+  // The cross net need a steiner point at the center.
+  Vector<Point> cross{{0, 5}, {10, 5}, {5, 0}, {5, 10}};
+  int64_t mst = SteinerTree::mstWirelength(cross);
+  int64_t steiner = SteinerTree::steinerWirelength(cross);
+  EXPECT_EQ(mst, 30);
+  EXPECT_LT(steiner, mst);
+  EXPECT_GE(steiner, 20);
+}
+
+TEST(SteinerTreeTest, batch) {
+  Vector<Point> points{{0, 0},  {10, 0}, {0, 10}, {10, 10}, {0, 5},
+                       {10, 5}, {5, 0},  {5, 10}, {1, 1}};
+  Vector<int> net_offsets{0, 4, 8, 9};
+
+  Vector<int64_t> result;
+  SteinerTree::batchWirelength(points, net_offsets, WirelengthModel::kMST,
+                               &result, 2);
+  ASSERT_EQ(result.size(), 3);
+  EXPECT_EQ(result[0], 30);
+  EXPECT_EQ(result[1], 30);
+  EXPECT_EQ(result[2], 0);
+
+  Vector<int64_t> steiner;
+  SteinerTree::batchWirelength(points, net_offsets, WirelengthModel::kSteiner,
+                               &steiner, 3);
+  pcl::WirelengthWorkspace workspace;
+  for (int i = 0; i < 3; ++i) {
+    int num = net_offsets[i + 1] - net_offsets[i];
+    EXPECT_EQ(steiner[i], SteinerTree::steinerWirelength(
+                              points.data() + net_offsets[i], num, &workspace));
+    EXPECT_LE(steiner[i], result[i]);
+  }
+}
+
+}  // namespace
@@ -1,4 +1,8 @@
 #include <iostream>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
 
 #include "Vector.h"
 #include "gtest/gtest.h"
@@ -160,3 +164,120 @@ TEST(VectorTest, maxNum) {
     std::cout << *it5 << std::endl;
   }
 }
+
+TEST(VectorTest, inlineCapacity) {
+  EXPECT_EQ(sizeof(pcl::Vector<double>), 64);
+  EXPECT_EQ(sizeof(pcl::Vector<char>), 64);
+  EXPECT_EQ(pcl::Vector<double>::kInlineSize, 7);
+  EXPECT_EQ(sizeof(pcl::HeapVector<double>), sizeof(std::vector<double>));
+  EXPECT_LT(sizeof(pcl::VectorN<int*, 4>), sizeof(pcl::Vector<int*>));
+  // The allocator is still the second parameter of Vector.
+  EXPECT_TRUE((std::is_same<pcl::Vector<int, std::allocator<int>>,
+                            pcl::Vector<int>>::value));
+
+  pcl::VectorN<int, 4> small{1, 2, 3, 4};
+  EXPECT_FALSE(small.isHeapAllocated());
+  EXPECT_EQ(small.memoryBytes(), sizeof(small));
+  small.push_back(5);
+  EXPECT_TRUE(small.isHeapAllocated());
+  EXPECT_EQ(small.memoryBytes(),
+            sizeof(small) + small.capacity() * sizeof(int));
+
+  pcl::HeapVector<int> heap{1, 2, 3, 2};
+  EXPECT_TRUE(heap.isHeapAllocated());
+  EXPECT_EQ(heap.count(2), 2);
+  EXPECT_TRUE(heap.contains(3));
+  EXPECT_EQ(heap.indexOf(2, 2), 3);
+  heap += 5;
+  EXPECT_EQ(heap[4], 5);
+  EXPECT_TRUE(heap < pcl::HeapVector<int>({1, 2, 4}));
+  pcl::HeapVector<int> moved = std::move(heap);
+  EXPECT_EQ(moved.size(), 5);
+
+  // The pin vectors of 10000 nets with 4 pins each.
+  auto footprint = [](auto pins) {
+    size_t bytes = 0;
+    std::vector<decltype(pins)> nets(10000, pins);
+    for (auto& net_pins : nets) {
+      bytes += net_pins.memoryBytes();
+    }
+    std::cout << "sizeof " << sizeof(pins) << " footprint " << bytes
+              << std::endl;
+    return bytes;
+  };
+  int pin = 0;
+  size_t old_bytes = footprint(pcl::VectorN<int*, 256>(4, &pin));
+  size_t default_bytes = footprint(pcl::Vector<int*>(4, &pin));
+  size_t fit_bytes = footprint(pcl::VectorN<int*, 4>(4, &pin));
+  size_t heap_bytes = footprint(pcl::HeapVector<int*>(4, &pin));
+  EXPECT_LT(default_bytes * 20, old_bytes);
+  EXPECT_LT(fit_bytes, default_bytes);
+  EXPECT_LT(heap_bytes, default_bytes);
+}
+
+TEST(VectorTest, concat) {
+  pcl::Vector<int> ev1{1, 2, 3};
+  pcl::Vector<int> ev2{4, 5};
+  pcl::Vector<int> ev3 = ev1 + ev2;
+  EXPECT_EQ(ev3, pcl::Vector<int>({1, 2, 3, 4, 5}));
+  EXPECT_EQ(ev1.size(), 3);
+  EXPECT_EQ(ev1 + ev2 + ev1, pcl::Vector<int>({1, 2, 3, 4, 5, 1, 2, 3}));
+  EXPECT_EQ(ev1 + (ev2 + ev2), pcl::Vector<int>({1, 2, 3, 4, 5, 4, 5}));
+
+  EXPECT_EQ(ev3.mid(1, 2), pcl::Vector<int>({2, 3}));
+  EXPECT_EQ(ev3.mid(3, 100), pcl::Vector<int>({4, 5}));
+  EXPECT_TRUE(ev3.mid(10, 2).empty());
+
+  pcl::VectorN<std::unique_ptr<int>, 2> owners1;
+  pcl::VectorN<std::unique_ptr<int>, 2> owners2;
+  for (int i = 0; i < 3; ++i) {
+    owners1.push_back(std::make_unique<int>(i));
+    owners2.push_back(std::make_unique<int>(i + 3));
+  }
+  auto owners = std::move(owners1) + std::move(owners2);
+  EXPECT_EQ(owners.size(), 6);
+  EXPECT_EQ(*owners[4], 4);
+  auto tail = std::move(owners).mid(4, 2);
+  EXPECT_EQ(*tail[1], 5);
+
+  pcl::HeapVector<std::string> names{"a", "b"};
+  auto more = names + pcl::HeapVector<std::string>{"c"};
+  EXPECT_EQ(more.size(), 3);
+  EXPECT_EQ(more[2], "c");
+}
+
+TEST(VectorTest, slice) {
+  pcl::Vector<int> ev{1, 2, 3, 4, 5};
+  auto view = ev.slice(1, 3);
+  EXPECT_EQ(view.size(), 3);
+  EXPECT_EQ(view.data(), ev.data() + 1);
+  view[0] = 20;
+  EXPECT_EQ(ev[1], 20);
+  EXPECT_EQ(ev.slice(3).size(), 2);
+  EXPECT_TRUE(ev.slice(9, 2).empty());
+
+  const pcl::Vector<int>& cev = ev;
+  absl::Span<const int> cview = cev.slice(4, 10);
+  EXPECT_EQ(cview.size(), 1);
+  EXPECT_EQ(cview[0], 5);
+}
+
+TEST(VectorTest, search) {
+  pcl::Vector<int> ev{7, 1, 2, 7, 3, 7};
+  EXPECT_TRUE(ev.contains(3));
+  EXPECT_FALSE(ev.contains(4));
+  EXPECT_EQ(ev.count(7), 3);
+  EXPECT_EQ(ev.indexOf(7), 0);
+  EXPECT_EQ(ev.indexOf(7, 1), 3);
+  EXPECT_EQ(ev.indexOf(7, 6), -1);
+  EXPECT_EQ(ev.endIndexOf(7), 5);
+  EXPECT_EQ(ev.endIndexOf(7, 4), 3);
+  EXPECT_EQ(ev.endIndexOf(7, 0), 0);
+  EXPECT_EQ(ev.endIndexOf(7, -4), 0);
+  EXPECT_EQ(ev.endIndexOf(7, -7), -1);
+  EXPECT_EQ(pcl::Vector<int>().endIndexOf(7), -1);
+
+  pcl::HeapVector<std::string> names{"a", "b", "a"};
+  EXPECT_EQ(names.endIndexOf("a"), 2);
+  EXPECT_EQ(names.indexOf("b"), 1);
+}